@@ -3,7 +3,7 @@
 #include "Formatters/JsonOutputArchiveFormatter.h"
 
 #if WITH_TEXT_ARCHIVE_SUPPORT
-#include "DOM/JsonObject.h"
+#include "Misc/Base64.h"
 
 FArchive& FJsonOutputArchiveFormatter::GetUnderlyingArchive()
 {
@@ -18,43 +18,28 @@ bool FJsonOutputArchiveFormatter::HasDocumentTree() const
 
 void FJsonOutputArchiveFormatter::EnterRecord()
 {
-	const TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
-
-	if (Stack.Num() > 0)
-	{
-		FStackObject& Current = GetCurrent();
-
-		check(!Current.Field.IsEmpty());
-		Current.Object->SetObjectField(Current.Field, Object);
-	}
-	else
-	{
-		check(!RootObject.IsValid());
-		RootObject = Object;
-	}
-
-	Stack.Push(Object);
+	EnterScope(false);
+	Text.Add('{');
 }
 
 void FJsonOutputArchiveFormatter::LeaveRecord()
 {
-	Stack.Pop(EAllowShrinking::No);
+	Text.Add('}');
+	LeaveScope();
 }
 
 void FJsonOutputArchiveFormatter::EnterField(FArchiveFieldName Name)
 {
-	FStackObject& Current = GetCurrent();
-	check(!Current.bInStream);
-	Current.Field = FString(Name.Name);
+	check(!Stack.IsEmpty() && !Stack.Last().bIsArray);
+
+	// Copied, as the name may not outlive this call
+	PendingField = Name.Name;
+	bHasPendingField = true;
 }
 
 void FJsonOutputArchiveFormatter::LeaveField()
 {
-	FStackObject& Current = GetCurrent();
-	check(!Current.Field.IsEmpty());
-
-	Current.bInAttributedValueValue = false;
-	Current.Field.Reset();
+	bHasPendingField = false;
 }
 
 bool FJsonOutputArchiveFormatter::TryEnterField(FArchiveFieldName Name, bool bEnterWhenWriting)
@@ -65,7 +50,6 @@ bool FJsonOutputArchiveFormatter::TryEnterField(FArchiveFieldName Name, bool bEn
 
 void FJsonOutputArchiveFormatter::EnterArray(int32& NumElements)
 {
-	GetCurrent().StreamValues.Reserve(NumElements);
 	EnterStream();
 }
 
@@ -86,16 +70,14 @@ void FJsonOutputArchiveFormatter::LeaveArrayElement()
 
 void FJsonOutputArchiveFormatter::EnterStream()
 {
-	FStackObject& Current = GetCurrent();
-	Current.bInStream = true;
+	EnterScope(true);
+	Text.Add('[');
 }
 
 void FJsonOutputArchiveFormatter::LeaveStream()
 {
-	FStackObject& Current = GetCurrent();
-	Current.bInStream = false;
-	Current.Object->SetArrayField(Current.Field, Current.StreamValues);
-	Current.StreamValues.Reset();
+	Text.Add(']');
+	LeaveScope();
 }
 
 void FJsonOutputArchiveFormatter::EnterStreamElement()
@@ -148,7 +130,6 @@ void FJsonOutputArchiveFormatter::LeaveAttribute()
 
 void FJsonOutputArchiveFormatter::EnterAttributedValueValue()
 {
-	GetCurrent().bInAttributedValueValue = true;
 	EnterField(FArchiveFieldName(TEXT("_Value")));
 }
 
@@ -166,57 +147,58 @@ bool FJsonOutputArchiveFormatter::TryEnterAttributedValueValue()
 
 void FJsonOutputArchiveFormatter::Serialize(uint8& Value)
 {
-	SetNumberValue(Value);
+	WriteInteger(Value);
 }
 
 void FJsonOutputArchiveFormatter::Serialize(uint16& Value)
 {
-	SetNumberValue(Value);
+	WriteInteger(Value);
 }
 
 void FJsonOutputArchiveFormatter::Serialize(uint32& Value)
 {
-	SetNumberValue(Value);
+	WriteInteger(Value);
 }
 
 void FJsonOutputArchiveFormatter::Serialize(uint64& Value)
 {
-	SetNumberValue(Value);
+	WriteInteger(Value);
 }
 
 void FJsonOutputArchiveFormatter::Serialize(int8& Value)
 {
-	SetNumberValue(Value);
+	WriteInteger(Value);
 }
 
 void FJsonOutputArchiveFormatter::Serialize(int16& Value)
 {
-	SetNumberValue(Value);
+	WriteInteger(Value);
 }
 
 void FJsonOutputArchiveFormatter::Serialize(int32& Value)
 {
-	SetNumberValue(Value);
+	WriteInteger(Value);
 }
 
 void FJsonOutputArchiveFormatter::Serialize(int64& Value)
 {
-	SetNumberValue(Value);
+	WriteInteger(Value);
 }
 
 void FJsonOutputArchiveFormatter::Serialize(float& Value)
 {
-	SetNumberValue(Value);
+	WriteNumber(Value);
 }
 
 void FJsonOutputArchiveFormatter::Serialize(double& Value)
 {
-	SetNumberValue(Value);
+	WriteNumber(Value);
 }
 
 void FJsonOutputArchiveFormatter::Serialize(bool& Value)
 {
-	SetNumberValue(Value);
+	BeginValue();
+	WriteLiteral(Value ? "true" : "false");
 }
 
 void FJsonOutputArchiveFormatter::Serialize(UTF32CHAR& Value)
@@ -229,22 +211,25 @@ void FJsonOutputArchiveFormatter::Serialize(UTF32CHAR& Value)
 
 void FJsonOutputArchiveFormatter::Serialize(FString& Value)
 {
-	SetValue<FJsonValueString>(Value);
+	BeginValue();
+	WriteString(Value);
 }
 
 void FJsonOutputArchiveFormatter::Serialize(FName& Value)
 {
-	SetValue<FJsonValueString>(Value.ToString());
+	BeginValue();
+	WriteString(Value.ToString());
 }
 
 void FJsonOutputArchiveFormatter::Serialize(UObject*& Value)
 {
-	ObjSerialize(MoveTemp(Value));
+	ObjSerialize(Value);
 }
 
 void FJsonOutputArchiveFormatter::Serialize(FText& Value)
 {
-	SetValue<FJsonValueString>(Value.ToString());
+	BeginValue();
+	WriteString(Value.ToString());
 }
 
 void FJsonOutputArchiveFormatter::Serialize(FWeakObjectPtr& Value)
@@ -254,12 +239,14 @@ void FJsonOutputArchiveFormatter::Serialize(FWeakObjectPtr& Value)
 
 void FJsonOutputArchiveFormatter::Serialize(FSoftObjectPtr& Value)
 {
-	SetValue<FJsonValueString>(Value.ToString());
+	BeginValue();
+	WriteString(Value.ToString());
 }
 
 void FJsonOutputArchiveFormatter::Serialize(FSoftObjectPath& Value)
 {
-	SetValue<FJsonValueString>(Value.ToString());
+	BeginValue();
+	WriteString(Value.ToString());
 }
 
 void FJsonOutputArchiveFormatter::Serialize(FLazyObjectPtr& Value)
@@ -274,56 +261,180 @@ void FJsonOutputArchiveFormatter::Serialize(FObjectPtr& Value)
 
 void FJsonOutputArchiveFormatter::Serialize(TArray<uint8>& Value)
 {
-	SetValue<FJsonValueString>(FBase64::Encode(Value));
+	Serialize(Value.GetData(), Value.Num());
 }
 
 void FJsonOutputArchiveFormatter::Serialize(void* Data, uint64 DataSize)
 {
-	SetValue<FJsonValueString>(FBase64::Encode(static_cast<const uint8*>(Data), DataSize));
+	if (PendingSplice.IsSet())
+	{
+		SerializeJson(PendingSplice.GetValue());
+		PendingSplice.Reset();
+		return;
+	}
+
+	BeginValue();
+	WriteString(FBase64::Encode(static_cast<const uint8*>(Data), DataSize));
 }
 
-void FJsonOutputArchiveFormatter::Serialize(const TSharedRef<FJsonObject>& Value)
+void FJsonOutputArchiveFormatter::SerializeJson(TConstArrayView<uint8> Json)
 {
-	SetValue(MakeShared<FJsonValueObject>(Value));
+	BeginValue();
+	WriteUtf8(Json);
+}
+
+void FJsonOutputArchiveFormatter::SpliceNextBlob(TConstArrayView<uint8> Json)
+{
+	PendingSplice = Json;
 }
 
 void FJsonOutputArchiveFormatter::ObjSerialize(const UObject* Value)
 {
+	BeginValue();
+
 	if (Value)
 	{
-		SetValue<FJsonValueString>(Value->GetPathName());
+		WriteString(Value->GetPathName());
 	}
 	else
 	{
-		SetValue(MakeShared<FJsonValueNull>());
+		WriteLiteral("null");
 	}
 }
 
-template <typename ValueType>
-void FJsonOutputArchiveFormatter::SetNumberValue(const ValueType& Value)
+void FJsonOutputArchiveFormatter::BeginValue()
+{
+	if (Stack.IsEmpty())
+	{
+		// The root record
+		return;
+	}
+
+	FScope& Current = Stack.Last();
+
+	if (Current.bHasValues)
+	{
+		Text.Add(',');
+	}
+	Current.bHasValues = true;
+
+	if (!Current.bIsArray)
+	{
+		check(bHasPendingField);
+		WriteString(PendingField);
+		Text.Add(':');
+		bHasPendingField = false;
+	}
+}
+
+void FJsonOutputArchiveFormatter::EnterScope(bool bIsArray)
 {
-	SetValue<FJsonValueNumber>(Value);
+	BeginValue();
+	Stack.Push({bIsArray, false});
 }
 
-template <typename JsonValueType, typename ValueType>
-void FJsonOutputArchiveFormatter::SetValue(const ValueType& Value)
+void FJsonOutputArchiveFormatter::LeaveScope()
 {
-	SetValue(MakeShared<JsonValueType>(Value));
+	Stack.Pop(EAllowShrinking::No);
+}
+
+template <typename ValueType>
+void FJsonOutputArchiveFormatter::WriteInteger(ValueType Value)
+{
+	BeginValue();
+
+	TAnsiStringBuilder<24> Number;
+	if constexpr (std::is_signed_v<ValueType>)
+	{
+		Number.Appendf("%lld", static_cast<long long>(Value));
+	}
+	else
+	{
+		Number.Appendf("%llu", static_cast<unsigned long long>(Value));
+	}
+
+	WriteLiteral(Number);
 }
 
-void FJsonOutputArchiveFormatter::SetValue(const TSharedRef<FJsonValue>& Value)
+template <typename ValueType>
+void FJsonOutputArchiveFormatter::WriteNumber(ValueType Value)
 {
-	FStackObject& Current = GetCurrent();
-	check(!Current.Field.IsEmpty());
+	BeginValue();
+
+	if (!FMath::IsFinite(Value))
+	{
+		// JSON has no representation for these
+		WriteLiteral("null");
+		return;
+	}
 
-	if (Current.bInStream)
+	// Enough digits to read back the same value
+	TAnsiStringBuilder<32> Number;
+	if constexpr (std::is_same_v<ValueType, float>)
 	{
-		Current.StreamValues.Add(Value);
+		Number.Appendf("%.9g", static_cast<double>(Value));
 	}
 	else
 	{
-		Current.Object->RemoveField(Current.Field);
-		Current.Object->SetField(Current.Field, Value);
+		Number.Appendf("%.17g", Value);
 	}
+
+	WriteLiteral(Number);
+}
+
+void FJsonOutputArchiveFormatter::WriteString(FStringView Value)
+{
+	Text.Add('"');
+
+	int32 RunStart = 0;
+	const auto FlushRun = [this, &Value, &RunStart](int32 RunEnd)
+	{
+		if (RunEnd > RunStart)
+		{
+			const auto Converted = StringCast<UTF8CHAR>(Value.GetData() + RunStart, RunEnd - RunStart);
+			WriteUtf8(MakeArrayView(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length()));
+		}
+		RunStart = RunEnd + 1;
+	};
+
+	for (int32 CharIdx = 0; CharIdx < Value.Len(); ++CharIdx)
+	{
+		const TCHAR Char = Value[CharIdx];
+
+		if (Char != TEXT('"') && Char != TEXT('\\') && Char >= 0x20)
+		{
+			continue;
+		}
+
+		FlushRun(CharIdx);
+
+		switch (Char)
+		{
+		case TEXT('"'): WriteLiteral("\\\""); break;
+		case TEXT('\\'): WriteLiteral("\\\\"); break;
+		case TEXT('\n'): WriteLiteral("\\n"); break;
+		case TEXT('\r'): WriteLiteral("\\r"); break;
+		case TEXT('\t'): WriteLiteral("\\t"); break;
+		default:
+			{
+				TAnsiStringBuilder<8> Escaped;
+				Escaped.Appendf("\\u%04x", static_cast<uint32>(Char));
+				WriteLiteral(Escaped);
+			}
+		}
+	}
+
+	FlushRun(Value.Len());
+	Text.Add('"');
+}
+
+void FJsonOutputArchiveFormatter::WriteLiteral(FAnsiStringView Value)
+{
+	Text.Append(reinterpret_cast<const uint8*>(Value.GetData()), Value.Len());
+}
+
+void FJsonOutputArchiveFormatter::WriteUtf8(TConstArrayView<uint8> Value)
+{
+	Text.Append(Value.GetData(), Value.Num());
 }
 #endif
@@ -0,0 +1,361 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "Formatters/TracingArchiveFormatter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSaveGameFormatterTrace, Log, All);
+
+FString Tabber(const int32 NumTabs)
+{
+	FString Tabs;
+	Tabs.Reserve(NumTabs * 4);
+
+	for (int32 i = 0; i < NumTabs; ++i)
+	{
+		Tabs += TEXT("\t");
+	}
+
+	return Tabs;
+}
+
+FTracingArchiveFormatter::FTracingArchiveFormatter(FStructuredArchiveFormatter& InInner)
+	: StackDepth(INDEX_NONE)
+	  , Inner(InInner)
+{
+}
+
+FArchive& FTracingArchiveFormatter::GetUnderlyingArchive()
+{
+	return Inner.GetUnderlyingArchive();
+}
+
+bool FTracingArchiveFormatter::HasDocumentTree() const
+{
+	return Inner.HasDocumentTree();
+}
+
+void FTracingArchiveFormatter::EnterRecord()
+{
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCTION__);
+
+	++StackDepth;
+	Inner.EnterRecord();
+}
+
+void FTracingArchiveFormatter::LeaveRecord()
+{
+	--StackDepth;
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCTION__);
+
+	Inner.LeaveRecord();
+}
+
+void FTracingArchiveFormatter::EnterField(FArchiveFieldName Name)
+{
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs: %s"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCTION__, Name.Name);
+
+	Inner.EnterField(Name);
+}
+
+void FTracingArchiveFormatter::LeaveField()
+{
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCTION__);
+
+	Inner.LeaveField();
+}
+
+bool FTracingArchiveFormatter::TryEnterField(FArchiveFieldName Name, bool bEnterWhenWriting)
+{
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs: %s %i"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCTION__, Name.Name, bEnterWhenWriting);
+
+	return Inner.TryEnterField(Name, bEnterWhenWriting);
+}
+
+void FTracingArchiveFormatter::EnterArray(int32& NumElements)
+{
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs: %i"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCTION__, NumElements);
+
+	Inner.EnterArray(NumElements);
+}
+
+void FTracingArchiveFormatter::LeaveArray()
+{
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCTION__);
+
+	Inner.LeaveArray();
+}
+
+void FTracingArchiveFormatter::EnterArrayElement()
+{
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCTION__);
+
+	Inner.EnterArrayElement();
+}
+
+void FTracingArchiveFormatter::LeaveArrayElement()
+{
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCTION__);
+
+	Inner.LeaveArrayElement();
+}
+
+void FTracingArchiveFormatter::EnterStream()
+{
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCTION__);
+
+	Inner.EnterStream();
+}
+
+void FTracingArchiveFormatter::LeaveStream()
+{
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCTION__);
+
+	Inner.LeaveStream();
+}
+
+void FTracingArchiveFormatter::EnterStreamElement()
+{
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCTION__);
+
+	Inner.EnterStreamElement();
+}
+
+void FTracingArchiveFormatter::LeaveStreamElement()
+{
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCTION__);
+
+	Inner.LeaveStreamElement();
+}
+
+void FTracingArchiveFormatter::EnterMap(int32& NumElements)
+{
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs: %i"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCTION__, NumElements);
+
+	++StackDepth;
+	Inner.EnterMap(NumElements);
+}
+
+void FTracingArchiveFormatter::LeaveMap()
+{
+	--StackDepth;
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCTION__);
+
+	Inner.LeaveMap();
+}
+
+void FTracingArchiveFormatter::EnterMapElement(FString& Name)
+{
+	Inner.EnterMapElement(Name);
+}
+
+void FTracingArchiveFormatter::LeaveMapElement()
+{
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCTION__);
+
+	Inner.LeaveMapElement();
+}
+
+void FTracingArchiveFormatter::EnterAttributedValue()
+{
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCTION__);
+
+	++StackDepth;
+	Inner.EnterAttributedValue();
+}
+
+void FTracingArchiveFormatter::EnterAttribute(FArchiveFieldName AttributeName)
+{
+	Inner.EnterAttribute(AttributeName);
+}
+
+void FTracingArchiveFormatter::LeaveAttribute()
+{
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCTION__);
+
+	Inner.LeaveAttribute();
+}
+
+void FTracingArchiveFormatter::EnterAttributedValueValue()
+{
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCTION__);
+
+	Inner.EnterAttributedValueValue();
+}
+
+void FTracingArchiveFormatter::LeaveAttributedValue()
+{
+	--StackDepth;
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCTION__);
+
+	Inner.LeaveAttributedValue();
+}
+
+bool FTracingArchiveFormatter::TryEnterAttribute(FArchiveFieldName AttributeName, bool bEnterWhenWriting)
+{
+	return Inner.TryEnterAttribute(AttributeName, bEnterWhenWriting);
+}
+
+bool FTracingArchiveFormatter::TryEnterAttributedValueValue()
+{
+	return Inner.TryEnterAttributedValueValue();
+}
+
+void FTracingArchiveFormatter::Serialize(uint8& Value)
+{
+	Inner.Serialize(Value);
+
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs %u"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCSIG__, Value);
+}
+
+void FTracingArchiveFormatter::Serialize(uint16& Value)
+{
+	Inner.Serialize(Value);
+
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs %u"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCSIG__, Value);
+}
+
+void FTracingArchiveFormatter::Serialize(uint32& Value)
+{
+	Inner.Serialize(Value);
+
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs %u"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCSIG__, Value);
+}
+
+void FTracingArchiveFormatter::Serialize(uint64& Value)
+{
+	Inner.Serialize(Value);
+
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs %llu"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCSIG__, Value);
+}
+
+void FTracingArchiveFormatter::Serialize(int8& Value)
+{
+	Inner.Serialize(Value);
+
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs %i"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCSIG__, Value);
+}
+
+void FTracingArchiveFormatter::Serialize(int16& Value)
+{
+	Inner.Serialize(Value);
+
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs %i"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCSIG__, Value);
+}
+
+void FTracingArchiveFormatter::Serialize(int32& Value)
+{
+	Inner.Serialize(Value);
+
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs %i"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCSIG__, Value);
+}
+
+void FTracingArchiveFormatter::Serialize(int64& Value)
+{
+	Inner.Serialize(Value);
+
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs %lld"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCSIG__, Value);
+}
+
+void FTracingArchiveFormatter::Serialize(float& Value)
+{
+	Inner.Serialize(Value);
+
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs %f"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCSIG__, Value);
+}
+
+void FTracingArchiveFormatter::Serialize(double& Value)
+{
+	Inner.Serialize(Value);
+
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs %f"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCSIG__, Value);
+}
+
+void FTracingArchiveFormatter::Serialize(bool& Value)
+{
+	Inner.Serialize(Value);
+
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs Bool %i"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCSIG__, Value);
+}
+
+void FTracingArchiveFormatter::Serialize(UTF32CHAR& Value)
+{
+	Inner.Serialize(Value);
+
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs %u"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCSIG__, Value);
+}
+
+void FTracingArchiveFormatter::Serialize(FString& Value)
+{
+	Inner.Serialize(Value);
+
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs %s"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCSIG__, *Value);
+}
+
+void FTracingArchiveFormatter::Serialize(FName& Value)
+{
+	Inner.Serialize(Value);
+
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs %s"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCSIG__, *Value.ToString());
+}
+
+void FTracingArchiveFormatter::Serialize(UObject*& Value)
+{
+	Inner.Serialize(Value);
+
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs %s"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCSIG__, *GetNameSafe(Value));
+}
+
+void FTracingArchiveFormatter::Serialize(FText& Value)
+{
+	Inner.Serialize(Value);
+
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs %s"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCSIG__, *Value.ToString());
+}
+
+void FTracingArchiveFormatter::Serialize(FWeakObjectPtr& Value)
+{
+	Inner.Serialize(Value);
+
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs %s"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCSIG__, *GetNameSafe(Value.Get()));
+}
+
+void FTracingArchiveFormatter::Serialize(FSoftObjectPtr& Value)
+{
+	Inner.Serialize(Value);
+
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs %s"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCSIG__, *Value.ToString());
+}
+
+void FTracingArchiveFormatter::Serialize(FSoftObjectPath& Value)
+{
+	Inner.Serialize(Value);
+
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs %s"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCSIG__, *Value.ToString());
+}
+
+void FTracingArchiveFormatter::Serialize(FLazyObjectPtr& Value)
+{
+	Inner.Serialize(Value);
+
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs %s"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCSIG__, *GetNameSafe(Value.Get()));
+}
+
+void FTracingArchiveFormatter::Serialize(FObjectPtr& Value)
+{
+	Inner.Serialize(Value);
+
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs %s"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCSIG__, *GetNameSafe(Value.Get()));
+}
+
+void FTracingArchiveFormatter::Serialize(TArray<uint8>& Value)
+{
+	Inner.Serialize(Value);
+
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs Data %i bytes"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCSIG__, Value.Num());
+}
+
+void FTracingArchiveFormatter::Serialize(void* Data, uint64 DataSize)
+{
+	Inner.Serialize(Data, DataSize);
+
+	UE_LOG(LogSaveGameFormatterTrace, Verbose, TEXT("%llu: %s%hs Data %llu bytes"), GetUnderlyingArchive().Tell(), *Tabber(StackDepth), __FUNCSIG__, DataSize);
+}
@@ -0,0 +1,300 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "SaveGameCompression.h"
+
+#include "SaveGameSettings.h"
+#include "Algo/Sort.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
+
+DEFINE_LOG_CATEGORY_STATIC(LogSaveGameCompression, Log, All);
+
+FSaveGameCompressionDictionary::FSaveGameCompressionDictionary(TArray<uint8>&& InData)
+	: Data(MoveTemp(InData))
+	  , Hash(FMath::Max(FCrc::MemCrc32(Data.GetData(), Data.Num()), 1u))
+{
+	check(Data.Num() <= MaxSize);
+}
+
+const FSaveGameCompressionDictionary* FSaveGameCompressionDictionary::Get()
+{
+	static const TUniquePtr<FSaveGameCompressionDictionary> Dictionary = []() -> TUniquePtr<FSaveGameCompressionDictionary>
+	{
+		const FString& DictionaryPath = GetDefault<USaveGameSettings>()->CompressionDictionary;
+
+		if (DictionaryPath.IsEmpty())
+		{
+			return nullptr;
+		}
+
+		TArray<uint8> Data;
+		if (!FFileHelper::LoadFileToArray(Data, *(FPaths::ProjectContentDir() / DictionaryPath)))
+		{
+			UE_LOG(LogSaveGameCompression, Warning, TEXT("Couldn't load compression dictionary %s"), *DictionaryPath);
+			return nullptr;
+		}
+
+		if (Data.IsEmpty() || Data.Num() > MaxSize)
+		{
+			UE_LOG(LogSaveGameCompression, Warning, TEXT("Compression dictionary %s is empty or larger than %i bytes"),
+			       *DictionaryPath, MaxSize);
+			return nullptr;
+		}
+
+		return MakeUnique<FSaveGameCompressionDictionary>(MoveTemp(Data));
+	}();
+
+	return Dictionary.Get();
+}
+
+TArray<uint8> FSaveGameCompressionDictionary::Train(TConstArrayView<TConstArrayView<uint8>> Samples, int32 DictionarySize)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_TrainDictionary);
+
+	// Sequences shorter than this aren't worth referencing, so they aren't worth counting
+	constexpr int32 SegmentSize = sizeof(uint64);
+
+	// How much of a sample is copied around a shared sequence, so that longer matches can be made
+	constexpr int32 WindowSize = 64;
+
+	struct FSegment
+	{
+		int32 NumSamples = 0;
+		int32 LastSampleIdx = INDEX_NONE;
+		int32 SampleIdx = 0;
+		int32 Offset = 0;
+	};
+
+	auto GetSegmentKey = [](const uint8* Bytes)
+	{
+		uint64 Key;
+		FMemory::Memcpy(&Key, Bytes, sizeof(Key));
+		return Key;
+	};
+
+	DictionarySize = FMath::Clamp(DictionarySize, 0, MaxSize);
+
+	TMap<uint64, FSegment> Segments;
+	for (int32 SampleIdx = 0; SampleIdx < Samples.Num(); ++SampleIdx)
+	{
+		const TConstArrayView<uint8>& Sample = Samples[SampleIdx];
+
+		for (int32 Offset = 0; Offset + SegmentSize <= Sample.Num(); ++Offset)
+		{
+			FSegment& Segment = Segments.FindOrAdd(GetSegmentKey(Sample.GetData() + Offset));
+
+			// Only count each sample once, as we're after sequences that are common across samples
+			if (Segment.LastSampleIdx != SampleIdx)
+			{
+				if (Segment.NumSamples == 0)
+				{
+					Segment.SampleIdx = SampleIdx;
+					Segment.Offset = Offset;
+				}
+
+				Segment.LastSampleIdx = SampleIdx;
+				++Segment.NumSamples;
+			}
+		}
+	}
+
+	TArray<TPair<uint64, FSegment>> SharedSegments;
+	for (const TPair<uint64, FSegment>& Segment : Segments)
+	{
+		if (Segment.Value.NumSamples > 1)
+		{
+			SharedSegments.Add(Segment);
+		}
+	}
+
+	Algo::SortBy(SharedSegments, [](const TPair<uint64, FSegment>& Segment) { return Segment.Value.NumSamples; },
+	             TGreater<>());
+
+	TSet<uint64> CoveredSegments;
+	TArray<TConstArrayView<uint8>> Windows;
+	int32 Size = 0;
+
+	for (const TPair<uint64, FSegment>& Segment : SharedSegments)
+	{
+		if (Size >= DictionarySize)
+		{
+			break;
+		}
+
+		// Already in the dictionary, as part of a more common sequence's window
+		if (CoveredSegments.Contains(Segment.Key))
+		{
+			continue;
+		}
+
+		const TConstArrayView<uint8>& Sample = Samples[Segment.Value.SampleIdx];
+		const int32 Start = FMath::Max(0, Segment.Value.Offset - (WindowSize - SegmentSize) / 2);
+		const int32 Length = FMath::Min3(WindowSize, Sample.Num() - Start, DictionarySize - Size);
+
+		for (int32 Offset = Start; Offset + SegmentSize <= Start + Length; ++Offset)
+		{
+			CoveredSegments.Add(GetSegmentKey(Sample.GetData() + Offset));
+		}
+
+		Windows.Add(Sample.Slice(Start, Length));
+		Size += Length;
+	}
+
+	// Zlib references closer data more cheaply, so the most common sequences go at the end
+	TArray<uint8> Dictionary;
+	Dictionary.Reserve(Size);
+
+	for (int32 WindowIdx = Windows.Num() - 1; WindowIdx >= 0; --WindowIdx)
+	{
+		Dictionary.Append(Windows[WindowIdx]);
+	}
+
+	return Dictionary;
+}
+
+static ECompressionFlags GetCompressionFlags(ESaveGameCompressionLevel Level)
+{
+	switch (Level)
+	{
+	case ESaveGameCompressionLevel::Fastest:
+		return COMPRESS_BiasSpeed;
+	case ESaveGameCompressionLevel::Smallest:
+		return COMPRESS_BiasSize;
+	default:
+		return COMPRESS_NoFlags;
+	}
+}
+
+static int GetZlibLevel(ESaveGameCompressionLevel Level)
+{
+	switch (Level)
+	{
+	case ESaveGameCompressionLevel::Fastest:
+		return Z_BEST_SPEED;
+	case ESaveGameCompressionLevel::Smallest:
+		return Z_BEST_COMPRESSION;
+	default:
+		return Z_DEFAULT_COMPRESSION;
+	}
+}
+
+static bool CompressZlibWithDictionary(TConstArrayView<uint8> Block, ESaveGameCompressionLevel Level,
+                                       const FSaveGameCompressionDictionary& Dictionary, TArray<uint8>& OutCompressed,
+                                       int32& OutCompressedSize)
+{
+	z_stream Stream = {};
+
+	if (deflateInit(&Stream, GetZlibLevel(Level)) != Z_OK)
+	{
+		return false;
+	}
+
+	const TConstArrayView<uint8> DictionaryData = Dictionary.GetData();
+	bool bCompressed = deflateSetDictionary(&Stream, DictionaryData.GetData(), DictionaryData.Num()) == Z_OK;
+
+	if (bCompressed)
+	{
+		OutCompressed.SetNumUninitialized(deflateBound(&Stream, Block.Num()));
+
+		Stream.next_in = const_cast<Bytef*>(Block.GetData());
+		Stream.avail_in = Block.Num();
+		Stream.next_out = OutCompressed.GetData();
+		Stream.avail_out = OutCompressed.Num();
+
+		bCompressed = deflate(&Stream, Z_FINISH) == Z_STREAM_END;
+		OutCompressedSize = Stream.total_out;
+	}
+
+	deflateEnd(&Stream);
+	return bCompressed;
+}
+
+static bool DecompressZlibWithDictionary(TConstArrayView<uint8> Compressed,
+                                         const FSaveGameCompressionDictionary& Dictionary, TArrayView<uint8> OutBlock)
+{
+	z_stream Stream = {};
+
+	if (inflateInit(&Stream) != Z_OK)
+	{
+		return false;
+	}
+
+	Stream.next_in = const_cast<Bytef*>(Compressed.GetData());
+	Stream.avail_in = Compressed.Num();
+	Stream.next_out = OutBlock.GetData();
+	Stream.avail_out = OutBlock.Num();
+
+	int Result = inflate(&Stream, Z_FINISH);
+
+	// The dictionary is requested once the stream's header has been read
+	if (Result == Z_NEED_DICT)
+	{
+		const TConstArrayView<uint8> DictionaryData = Dictionary.GetData();
+
+		if (inflateSetDictionary(&Stream, DictionaryData.GetData(), DictionaryData.Num()) == Z_OK)
+		{
+			Result = inflate(&Stream, Z_FINISH);
+		}
+	}
+
+	const bool bDecompressed = Result == Z_STREAM_END && Stream.total_out == static_cast<uLong>(OutBlock.Num());
+
+	inflateEnd(&Stream);
+	return bDecompressed;
+}
+
+void FSaveGameCompression::CompressBlock(TConstArrayView<uint8> Block, FName Format, ESaveGameCompressionLevel Level,
+                                         TArray<uint8>& OutCompressed,
+                                         const FSaveGameCompressionDictionary* Dictionary)
+{
+	int32 CompressedSize = 0;
+	bool bCompressed;
+
+	if (Dictionary)
+	{
+		check(Format == NAME_Zlib);
+		bCompressed = CompressZlibWithDictionary(Block, Level, *Dictionary, OutCompressed, CompressedSize);
+	}
+	else
+	{
+		CompressedSize = FCompression::CompressMemoryBound(Format, Block.Num());
+		OutCompressed.SetNumUninitialized(CompressedSize);
+
+		bCompressed = FCompression::CompressMemory(Format, OutCompressed.GetData(), CompressedSize,
+		                                           Block.GetData(), Block.Num(), GetCompressionFlags(Level));
+	}
+
+	if (bCompressed && CompressedSize < Block.Num())
+	{
+		OutCompressed.SetNum(CompressedSize, EAllowShrinking::No);
+	}
+	else
+	{
+		// Not worth compressing, store it as is (the sizes being equal marks this on load)
+		OutCompressed.Reset();
+		OutCompressed.Append(Block.GetData(), Block.Num());
+	}
+}
+
+bool FSaveGameCompression::DecompressBlock(TConstArrayView<uint8> Compressed, FName Format, TArrayView<uint8> OutBlock,
+                                           const FSaveGameCompressionDictionary* Dictionary)
+{
+	if (Compressed.Num() == OutBlock.Num())
+	{
+		FMemory::Memcpy(OutBlock.GetData(), Compressed.GetData(), Compressed.Num());
+		return true;
+	}
+
+	if (Dictionary)
+	{
+		// The format comes from the container, which could've been written by something other than us
+		return Format == NAME_Zlib && DecompressZlibWithDictionary(Compressed, *Dictionary, OutBlock);
+	}
+
+	return FCompression::UncompressMemory(Format, OutBlock.GetData(), OutBlock.Num(), Compressed.GetData(), Compressed.Num());
+}
@@ -0,0 +1,697 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "SaveGameContainer.h"
+
+#include "SaveGameCompression.h"
+#include "SaveGameFileWriter.h"
+#include "PlatformFeatures.h"
+#include "Algo/BinarySearch.h"
+#include "Async/AsyncFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Compression.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Tasks/Task.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSaveGameContainer, Log, All);
+
+const uint32 FSaveGameContainer::ContainerTag = 0x53474354; // "SGCT"
+
+FString FSaveGameContainer::GetFilePath(const FString& SaveName)
+{
+	return FPaths::ProjectSavedDir() / TEXT("SaveGames") / SaveName + TEXT(".sav");
+}
+
+bool FSaveGameContainer::UsesGenericSaveGameSystem()
+{
+	// The base implementation only ever returns the generic save game system, platforms override it with their own
+	IPlatformFeaturesModule& PlatformFeatures = IPlatformFeaturesModule::Get();
+	return PlatformFeatures.GetSaveGameSystem() == PlatformFeatures.IPlatformFeaturesModule::GetSaveGameSystem();
+}
+
+FSaveGameTableOfContents::FSection FSaveGameTableOfContents::FLevelSection::GetActorSection(int32 ActorIdx) const
+{
+	FSection Section;
+	Section.Offset = Offset + ActorOffsets[ActorIdx];
+	Section.Size = (ActorOffsets.IsValidIndex(ActorIdx + 1) ? ActorOffsets[ActorIdx + 1] : Size) - ActorOffsets[ActorIdx];
+	return Section;
+}
+
+void FSaveGameTableOfContents::GetBlockRange(const FSection& Section, int32& OutFirstBlock, int32& OutNumBlocks) const
+{
+	// Find the first block that ends after the section starts
+	OutFirstBlock = Algo::UpperBoundBy(Blocks, Section.Offset, [](const FBlock& Block)
+	{
+		return Block.UncompressedOffset + Block.UncompressedSize;
+	});
+
+	int32 LastBlock = OutFirstBlock;
+	while (LastBlock < Blocks.Num() && Blocks[LastBlock].UncompressedOffset < Section.Offset + Section.Size)
+	{
+		++LastBlock;
+	}
+
+	OutNumBlocks = LastBlock - OutFirstBlock;
+}
+
+bool FSaveGameTableOfContents::IsValid(uint64 BlocksEnd) const
+{
+	if (!FCompression::IsFormatValid(CompressionFormat) || (DictionaryHash != 0 && CompressionFormat != NAME_Zlib))
+	{
+		return false;
+	}
+
+	uint64 BlockOffset = 0;
+	for (const FBlock& Block : Blocks)
+	{
+		if (Block.UncompressedOffset != BlockOffset || Block.UncompressedSize <= 0 || Block.CompressedSize <= 0
+			|| Block.CompressedOffset < FSaveGameContainer::PreambleSize || Block.CompressedOffset > BlocksEnd
+			|| static_cast<uint64>(Block.CompressedSize) > BlocksEnd - Block.CompressedOffset)
+		{
+			return false;
+		}
+
+		BlockOffset += Block.UncompressedSize;
+	}
+
+	if (BlockOffset != UncompressedSize || !IsValidSection(Header) || !IsValidSection(Versions)
+		|| !IsValidSection(Names))
+	{
+		return false;
+	}
+
+	for (const FLevelSection& Level : Levels)
+	{
+		if (!IsValidSection(Level))
+		{
+			return false;
+		}
+
+		// Each actor's data runs to the start of the next (or the end of the level)
+		uint32 PreviousOffset = 0;
+		for (const uint32 ActorOffset : Level.ActorOffsets)
+		{
+			if (ActorOffset < PreviousOffset || ActorOffset > Level.Size)
+			{
+				return false;
+			}
+
+			PreviousOffset = ActorOffset;
+		}
+	}
+
+	return true;
+}
+
+bool FSaveGameTableOfContents::IsValidSection(const FSection& Section) const
+{
+	return Section.Size <= MAX_int32 && Section.Offset <= UncompressedSize
+		&& Section.Size <= UncompressedSize - Section.Offset;
+}
+
+void FSaveGameTableOfContents::Serialize(FArchive& Ar, int32 ContainerVersion)
+{
+	FString FormatName = CompressionFormat.ToString();
+
+	Ar << FormatName;
+	Ar << UncompressedSize;
+
+	if (ContainerVersion >= FSaveGameContainer::CompressionDictionary)
+	{
+		Ar << DictionaryHash;
+	}
+
+	Ar << Blocks;
+	Ar << Header;
+	Ar << Versions;
+	Ar << Levels;
+
+	if (ContainerVersion >= FSaveGameContainer::NameTable)
+	{
+		Ar << Names;
+	}
+
+	if (Ar.IsLoading())
+	{
+		CompressionFormat = *FormatName;
+	}
+}
+
+FSaveGameContainerWriter::FSaveGameContainerWriter(FArchive& InArchive, FSaveGameSummary Summary,
+                                                   FName InFormat, ESaveGameCompressionLevel InLevel,
+                                                   int32 InBlockSize,
+                                                   const FSaveGameCompressionDictionary* InDictionary)
+	: Archive(InArchive)
+	  , Format(InFormat)
+	  , Level(InLevel)
+	  , BlockSize(InBlockSize)
+	  , Dictionary(InDictionary)
+{
+	check(Archive.IsSaving());
+	check(BlockSize > 0);
+
+	if (!FCompression::IsFormatValid(Format))
+	{
+		UE_LOG(LogSaveGameContainer, Warning, TEXT("Compression format %s isn't available, falling back to Zlib"),
+		       *Format.ToString());
+		Format = NAME_Zlib;
+	}
+
+	if (Dictionary && Format != NAME_Zlib)
+	{
+		UE_LOG(LogSaveGameContainer, Warning, TEXT("Compression dictionaries aren't supported by %s, ignoring it"),
+		       *Format.ToString());
+		Dictionary = nullptr;
+	}
+
+	uint32 Tag = FSaveGameContainer::ContainerTag;
+	int32 Version = FSaveGameContainer::LatestVersion;
+	int64 TocOffset = 0;
+
+	// The table of contents offset is filled out once finalized
+	Archive << Tag;
+	Archive << Version;
+	Archive << TocOffset;
+
+	// Sized up front, so that readers can fetch the summary in one read
+	TArray<uint8> SummaryData;
+	FMemoryWriter SummaryWriter(SummaryData);
+	SummaryWriter << Summary;
+
+	int32 SummarySize = SummaryData.Num();
+	check(SummarySize <= FSaveGameContainer::MaxSummarySize);
+
+	Archive << SummarySize;
+	Archive.Serialize(SummaryData.GetData(), SummarySize);
+}
+
+FSaveGameContainerWriter::FSaveGameContainerWriter(FSaveGameFileWriter& InFileWriter, FSaveGameSummary Summary,
+                                                   FName InFormat, ESaveGameCompressionLevel InLevel,
+                                                   int32 InBlockSize,
+                                                   const FSaveGameCompressionDictionary* InDictionary)
+	: FSaveGameContainerWriter(static_cast<FArchive&>(InFileWriter), MoveTemp(Summary), InFormat, InLevel, InBlockSize,
+	                           InDictionary)
+{
+	FileWriter = &InFileWriter;
+}
+
+FSaveGameContainerWriter::~FSaveGameContainerWriter()
+{
+	// Our write tasks reference us, so make sure they're done
+	WriteTask.Wait();
+}
+
+void FSaveGameContainerWriter::Write(const FSharedBuffer& Data)
+{
+	FMemoryView Remaining = Data.GetView();
+
+	while (!Remaining.IsEmpty())
+	{
+		const int32 NumToAppend = IntCastChecked<int32>(FMath::Min<uint64>(Remaining.GetSize(), BlockSize - PendingSize));
+
+		// Views of the buffer keep it alive, so that it can be split between blocks without being copied
+		PendingBuffers.Add(FSharedBuffer::MakeView(Remaining.Left(NumToAppend), Data));
+		PendingSize += NumToAppend;
+		Remaining += NumToAppend;
+
+		if (PendingSize == BlockSize)
+		{
+			Flush();
+		}
+	}
+}
+
+void FSaveGameContainerWriter::Flush()
+{
+	if (PendingSize == 0)
+	{
+		return;
+	}
+
+	FSaveGameTableOfContents::FBlock Block;
+	Block.UncompressedOffset = UncompressedSize;
+	Block.UncompressedSize = PendingSize;
+	UncompressedSize += Block.UncompressedSize;
+
+	UE::Tasks::TTask<TArray<uint8>> CompressTask = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[this, Buffers = MoveTemp(PendingBuffers), Size = PendingSize]() mutable
+		{
+			QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_CompressBlock);
+
+			// A block of a single buffer (like an actor, when using a dictionary) can be compressed where it is
+			TArray<uint8> Gathered;
+			TConstArrayView<uint8> Uncompressed;
+
+			if (Buffers.Num() == 1)
+			{
+				Uncompressed = MakeArrayView(static_cast<const uint8*>(Buffers[0].GetData()), Size);
+			}
+			else
+			{
+				Gathered.Reserve(Size);
+				for (const FSharedBuffer& Buffer : Buffers)
+				{
+					Gathered.Append(static_cast<const uint8*>(Buffer.GetData()), IntCastChecked<int32>(Buffer.GetSize()));
+				}
+
+				Uncompressed = Gathered;
+			}
+
+			TArray<uint8> Compressed;
+			FSaveGameCompression::CompressBlock(Uncompressed, Format, Level, Compressed, Dictionary);
+
+			// The buffers are no longer needed, release them (if we were the last to reference them) straight away
+			Buffers.Empty();
+			return Compressed;
+		});
+
+	WriteTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, CompressTask, Block]() mutable
+	{
+		TArray<uint8>& Compressed = CompressTask.GetResult();
+
+		Block.CompressedOffset = Archive.Tell();
+		Block.CompressedSize = Compressed.Num();
+		Blocks.Add(Block);
+
+		if (FileWriter)
+		{
+			FileWriter->Write(MakeSharedBufferFromArray(MoveTemp(Compressed)));
+		}
+		else
+		{
+			Archive.Serialize(Compressed.GetData(), Compressed.Num());
+		}
+	}, UE::Tasks::Prerequisites(CompressTask, WriteTask));
+
+	PendingBuffers.Reset();
+	PendingSize = 0;
+}
+
+void FSaveGameContainerWriter::Finalize(FSaveGameTableOfContents& Toc)
+{
+	Flush();
+	WriteTask.Wait();
+
+	Toc.CompressionFormat = Format;
+	Toc.UncompressedSize = UncompressedSize;
+	Toc.DictionaryHash = Dictionary ? Dictionary->GetHash() : 0;
+	Toc.Blocks = MoveTemp(Blocks);
+
+	int64 TocOffset = Archive.Tell();
+	Toc.Serialize(Archive, FSaveGameContainer::LatestVersion);
+
+	const int64 EndOffset = Archive.Tell();
+
+	// Go back and fill out where our table of contents is
+	Archive.Seek(FSaveGameContainer::PreambleSize - sizeof(int64));
+	Archive << TocOffset;
+	Archive.Seek(EndOffset);
+}
+
+FSaveGameContainerReader::~FSaveGameContainerReader()
+{
+	Close();
+}
+
+bool FSaveGameContainerReader::Open(const FString& FilePath)
+{
+	const int64 ContainerSize = OpenFile(FilePath);
+	return ContainerSize != INDEX_NONE && ReadTableOfContents(ContainerSize);
+}
+
+bool FSaveGameContainerReader::Open(TArray<uint8>&& InContainerData)
+{
+	ContainerData = MoveTemp(InContainerData);
+	return ReadTableOfContents(ContainerData.Num());
+}
+
+bool FSaveGameContainerReader::OpenSummary(const FString& FilePath)
+{
+	const int64 ContainerSize = OpenFile(FilePath);
+	const bool bRead = ContainerSize != INDEX_NONE && ReadPreamble(ContainerSize) != INDEX_NONE;
+
+	// Nothing else will be read, so don't keep the file open
+	Close();
+	return bRead;
+}
+
+void FSaveGameContainerReader::Close()
+{
+	FileHandle.Reset();
+	ContainerData.Empty();
+	CachedBlockIdx = INDEX_NONE;
+	CachedBlock.Empty();
+}
+
+int64 FSaveGameContainerReader::OpenFile(const FString& FilePath)
+{
+	FileHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenAsyncRead(*FilePath));
+
+	if (!FileHandle.IsValid())
+	{
+		UE_LOG(LogSaveGameContainer, Error, TEXT("Couldn't open save game container %s"), *FilePath);
+		return INDEX_NONE;
+	}
+
+	IAsyncReadRequest* SizeRequest = FileHandle->SizeRequest();
+	SizeRequest->WaitCompletion();
+	const int64 ContainerSize = SizeRequest->GetSizeResults();
+	delete SizeRequest;
+
+	return ContainerSize;
+}
+
+int64 FSaveGameContainerReader::ReadPreamble(int64 ContainerSize)
+{
+	// Read as much as a small summary would need, so that it usually comes with the preamble
+	constexpr int64 InitialReadSize = 1024;
+
+	TArray<uint8> Preamble;
+	if (ContainerSize < FSaveGameContainer::PreambleSize
+		|| !ReadRange(0, FMath::Min(ContainerSize, InitialReadSize), Preamble))
+	{
+		UE_LOG(LogSaveGameContainer, Error, TEXT("Save game container is truncated"));
+		return INDEX_NONE;
+	}
+
+	FMemoryReader PreambleReader(Preamble);
+
+	uint32 Tag = 0;
+	int64 TocOffset = 0;
+
+	PreambleReader << Tag;
+
+	if (Tag != FSaveGameContainer::ContainerTag)
+	{
+		// Saves from before containers were a compressed archive, which starts with its size and then a package tag
+		int64 UncompressedSize = 0;
+		uint32 PackageTag = 0;
+		PreambleReader.Seek(0);
+		PreambleReader << UncompressedSize << PackageTag;
+
+		if (PackageTag == PACKAGE_FILE_TAG)
+		{
+			UE_LOG(LogSaveGameContainer, Error,
+			       TEXT("Save game predates save game containers, saves from before then aren't supported"));
+		}
+		else
+		{
+			UE_LOG(LogSaveGameContainer, Error, TEXT("Not a save game container (tag: 0x%08x)"), Tag);
+		}
+
+		return INDEX_NONE;
+	}
+
+	PreambleReader << Version;
+
+	if (Version > FSaveGameContainer::LatestVersion)
+	{
+		UE_LOG(LogSaveGameContainer, Error, TEXT("Save game container version %i is newer than supported (%i)"),
+		       Version, FSaveGameContainer::LatestVersion);
+		return INDEX_NONE;
+	}
+
+	PreambleReader << TocOffset;
+
+	if (TocOffset < FSaveGameContainer::PreambleSize || TocOffset >= ContainerSize)
+	{
+		UE_LOG(LogSaveGameContainer, Error, TEXT("Save game container's table of contents is missing"));
+		return INDEX_NONE;
+	}
+
+	Summary.Reset();
+
+	if (Version >= FSaveGameContainer::Summary)
+	{
+		int32 SummarySize = 0;
+		PreambleReader << SummarySize;
+
+		const int64 SummaryOffset = PreambleReader.Tell();
+
+		if (PreambleReader.IsError() || SummarySize < 0 || SummarySize > FSaveGameContainer::MaxSummarySize
+			|| SummaryOffset + SummarySize > TocOffset)
+		{
+			UE_LOG(LogSaveGameContainer, Error, TEXT("Save game container's summary is corrupt"));
+			return INDEX_NONE;
+		}
+
+		// Larger summaries need another read
+		TArray<uint8> SummaryData;
+		if (SummaryOffset + SummarySize <= Preamble.Num())
+		{
+			SummaryData.Append(Preamble.GetData() + SummaryOffset, SummarySize);
+		}
+		else if (!ReadRange(SummaryOffset, SummarySize, SummaryData))
+		{
+			UE_LOG(LogSaveGameContainer, Error, TEXT("Save game container is truncated"));
+			return INDEX_NONE;
+		}
+
+		FMemoryReader SummaryReader(SummaryData);
+		SummaryReader << Summary.Emplace();
+
+		if (SummaryReader.IsError())
+		{
+			UE_LOG(LogSaveGameContainer, Error, TEXT("Save game container's summary is corrupt"));
+			Summary.Reset();
+			return INDEX_NONE;
+		}
+	}
+
+	return TocOffset;
+}
+
+bool FSaveGameContainerReader::ReadTableOfContents(int64 ContainerSize)
+{
+	const int64 TocOffset = ReadPreamble(ContainerSize);
+
+	if (TocOffset == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// The table of contents runs to the end of the container
+	TArray<uint8> TocData;
+	if (!ReadRange(TocOffset, ContainerSize - TocOffset, TocData))
+	{
+		UE_LOG(LogSaveGameContainer, Error, TEXT("Save game container's table of contents is missing"));
+		return false;
+	}
+
+	FMemoryReader TocReader(TocData);
+	Toc.Serialize(TocReader, Version);
+
+	// Everything that's read later is trusted to be within the container, as validated here
+	if (TocReader.IsError() || !Toc.IsValid(TocOffset))
+	{
+		UE_LOG(LogSaveGameContainer, Error, TEXT("Save game container's table of contents is corrupt"));
+		return false;
+	}
+
+	if (Toc.DictionaryHash != 0)
+	{
+		Dictionary = FSaveGameCompressionDictionary::Get();
+
+		if (Dictionary == nullptr || Dictionary->GetHash() != Toc.DictionaryHash)
+		{
+			UE_LOG(LogSaveGameContainer, Error,
+			       TEXT("Save game container needs a compression dictionary (hash: 0x%08x) that isn't loaded"),
+			       Toc.DictionaryHash);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FSaveGameContainerReader::ReadRange(int64 Offset, int64 Size, TArray<uint8>& OutData)
+{
+	if (Offset < 0 || Size < 0 || Size > MAX_int32)
+	{
+		return false;
+	}
+
+	OutData.SetNumUninitialized(static_cast<int32>(Size));
+
+	if (FileHandle.IsValid())
+	{
+		IAsyncReadRequest* Request = FileHandle->ReadRequest(Offset, Size, AIOP_Normal, nullptr, OutData.GetData());
+
+		if (Request == nullptr)
+		{
+			return false;
+		}
+
+		Request->WaitCompletion();
+		const bool bRead = Request->GetReadResults() != nullptr;
+		delete Request;
+
+		return bRead;
+	}
+
+	if (Offset + Size > ContainerData.Num())
+	{
+		return false;
+	}
+
+	FMemory::Memcpy(OutData.GetData(), ContainerData.GetData() + Offset, Size);
+	return true;
+}
+
+bool FSaveGameContainerReader::ReadSection(const FSaveGameTableOfContents::FSection& Section, TArray<uint8>& OutData)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_ReadSection);
+
+	// The blocks cover all of the uncompressed data (see FSaveGameTableOfContents::IsValid), so they cover any section
+	// that's within it, and only overlapping blocks are in the section's block range
+	if (!Toc.IsValidSection(Section))
+	{
+		return false;
+	}
+
+	int32 FirstBlock, NumBlocks;
+	Toc.GetBlockRange(Section, FirstBlock, NumBlocks);
+
+	OutData.SetNumUninitialized(static_cast<int32>(Section.Size));
+
+	const uint64 SectionEnd = Section.Offset + Section.Size;
+
+	// Start reading all of the section's blocks up front, each is decompressed by a task once it has arrived, so that
+	// no task worker waits on the file
+	TArray<TArray<uint8>> CompressedBlocks;
+	TArray<IAsyncReadRequest*> Requests;
+	TArray<FAsyncFileCallBack> ReadCallbacks;
+	TArray<bool> ReadResults;
+	CompressedBlocks.SetNum(NumBlocks);
+	Requests.SetNumZeroed(NumBlocks);
+	ReadCallbacks.SetNum(NumBlocks);
+	ReadResults.SetNumZeroed(NumBlocks);
+
+	std::atomic<bool> bSucceeded = true;
+	TArray<uint8> LastBlock;
+
+	auto DecompressBlock = [&](int32 Idx)
+	{
+		const int32 BlockIdx = FirstBlock + Idx;
+		const FSaveGameTableOfContents::FBlock& Block = Toc.Blocks[BlockIdx];
+		const uint64 BlockEnd = Block.UncompressedOffset + Block.UncompressedSize;
+
+		// The part of this block that overlaps our section
+		const uint64 CopyStart = FMath::Max(Section.Offset, Block.UncompressedOffset);
+		const uint64 CopyEnd = FMath::Min(SectionEnd, BlockEnd);
+		uint8* CopyDest = OutData.GetData() + (CopyStart - Section.Offset);
+
+		if (BlockIdx == CachedBlockIdx)
+		{
+			FMemory::Memcpy(CopyDest, CachedBlock.GetData() + (CopyStart - Block.UncompressedOffset), CopyEnd - CopyStart);
+			return;
+		}
+
+		TConstArrayView<uint8> Compressed;
+		if (FileHandle.IsValid())
+		{
+			if (ReadResults[Idx])
+			{
+				Compressed = CompressedBlocks[Idx];
+			}
+		}
+		else if (Block.CompressedOffset + Block.CompressedSize <= static_cast<uint64>(ContainerData.Num()))
+		{
+			Compressed = MakeArrayView(ContainerData.GetData() + Block.CompressedOffset, Block.CompressedSize);
+		}
+
+		if (Compressed.Num() != Block.CompressedSize)
+		{
+			bSucceeded = false;
+			return;
+		}
+
+		// Blocks that are entirely within our section can be decompressed in place
+		const bool bInPlace = CopyStart == Block.UncompressedOffset && CopyEnd == BlockEnd && Idx != NumBlocks - 1;
+
+		TArray<uint8> Uncompressed;
+		if (!bInPlace)
+		{
+			Uncompressed.SetNumUninitialized(Block.UncompressedSize);
+		}
+
+		const TArrayView<uint8> Destination = bInPlace
+			                                      ? MakeArrayView(CopyDest, Block.UncompressedSize)
+			                                      : MakeArrayView(Uncompressed);
+
+		if (!FSaveGameCompression::DecompressBlock(Compressed, Toc.CompressionFormat, Destination, Dictionary))
+		{
+			bSucceeded = false;
+			return;
+		}
+
+		CompressedBlocks[Idx].Empty();
+
+		if (!bInPlace)
+		{
+			FMemory::Memcpy(CopyDest, Uncompressed.GetData() + (CopyStart - Block.UncompressedOffset), CopyEnd - CopyStart);
+
+			if (Idx == NumBlocks - 1)
+			{
+				LastBlock = MoveTemp(Uncompressed);
+			}
+		}
+	};
+
+	TArray<UE::Tasks::FTask> DecompressTasks;
+	DecompressTasks.Reserve(NumBlocks);
+
+	for (int32 Idx = 0; Idx < NumBlocks; ++Idx)
+	{
+		const FSaveGameTableOfContents::FBlock& Block = Toc.Blocks[FirstBlock + Idx];
+
+		if (!FileHandle.IsValid() || FirstBlock + Idx == CachedBlockIdx)
+		{
+			DecompressTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [&DecompressBlock, Idx] { DecompressBlock(Idx); }));
+			continue;
+		}
+
+		// The read's completion (on the I/O thread) only releases the block's task
+		UE::Tasks::FTaskEvent ReadEvent(UE_SOURCE_LOCATION);
+		DecompressTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [&DecompressBlock, Idx] { DecompressBlock(Idx); },
+		                                      ReadEvent));
+
+		ReadCallbacks[Idx] = [&ReadResults, Idx, ReadEvent](bool bWasCancelled, IAsyncReadRequest* Request) mutable
+		{
+			ReadResults[Idx] = !bWasCancelled && Request->GetReadResults() != nullptr;
+			ReadEvent.Trigger();
+		};
+
+		CompressedBlocks[Idx].SetNumUninitialized(Block.CompressedSize);
+		Requests[Idx] = FileHandle->ReadRequest(Block.CompressedOffset, Block.CompressedSize, AIOP_Normal,
+		                                        &ReadCallbacks[Idx], CompressedBlocks[Idx].GetData());
+
+		// The read couldn't be started, so its block fails rather than waiting forever
+		if (Requests[Idx] == nullptr)
+		{
+			ReadEvent.Trigger();
+		}
+	}
+
+	// Only the calling thread waits, it has nothing else to do until its section has been read
+	UE::Tasks::Wait(DecompressTasks);
+
+	for (IAsyncReadRequest* Request : Requests)
+	{
+		if (Request)
+		{
+			// Already complete, as its block has been decompressed
+			Request->WaitCompletion();
+			delete Request;
+		}
+	}
+
+	if (!LastBlock.IsEmpty())
+	{
+		CachedBlockIdx = FirstBlock + NumBlocks - 1;
+		CachedBlock = MoveTemp(LastBlock);
+	}
+
+	return bSucceeded;
+}
@@ -0,0 +1,185 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "SaveGameFileWriter.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSaveGameFileWriter, Log, All);
+
+FSaveGameFileWriter::FSaveGameFileWriter(const FString& InFilePath)
+	: FilePath(InFilePath)
+	  , TempFilePath(InFilePath + TEXT(".tmp"))
+{
+	SetIsSaving(true);
+	SetIsPersistent(true);
+
+	Handle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*TempFilePath));
+
+	if (!Handle.IsValid())
+	{
+		UE_LOG(LogSaveGameFileWriter, Error, TEXT("Couldn't open %s for writing"), *TempFilePath);
+		SetError();
+	}
+}
+
+FSaveGameFileWriter::~FSaveGameFileWriter()
+{
+	// Our writes reference us
+	IoPipe.WaitUntilEmpty();
+
+	if (!bCommitted && Handle.IsValid())
+	{
+		Handle.Reset();
+		IFileManager::Get().Delete(*TempFilePath);
+	}
+}
+
+void FSaveGameFileWriter::Serialize(void* Data, int64 Num)
+{
+	check(!bCommitted);
+
+	if (Num <= 0 || IsError())
+	{
+		return;
+	}
+
+	if (Num >= SmallWriteSize)
+	{
+		Write(FSharedBuffer::Clone(Data, Num));
+		return;
+	}
+
+	// A chunk is one contiguous range of the file, so anything written after a seek starts a new one
+	if (Pos != ChunkOffset + ChunkNum)
+	{
+		FlushChunk();
+	}
+
+	SmallWrites.Append(static_cast<const uint8*>(Data), static_cast<int32>(Num));
+	ChunkNum += Num;
+	Pos += Num;
+	Size = FMath::Max(Size, Pos);
+
+	if (ChunkNum >= ChunkSize)
+	{
+		FlushChunk();
+	}
+}
+
+void FSaveGameFileWriter::Write(FSharedBuffer Buffer)
+{
+	check(!bCommitted);
+
+	const int64 Num = static_cast<int64>(Buffer.GetSize());
+
+	if (Num == 0 || IsError())
+	{
+		return;
+	}
+
+	if (Pos != ChunkOffset + ChunkNum)
+	{
+		FlushChunk();
+	}
+
+	// Keep the order of what was written
+	EndSmallWrites();
+
+	Chunk.Add(MoveTemp(Buffer));
+	ChunkNum += Num;
+	Pos += Num;
+	Size = FMath::Max(Size, Pos);
+
+	if (ChunkNum >= ChunkSize)
+	{
+		FlushChunk();
+	}
+}
+
+void FSaveGameFileWriter::Seek(int64 InPos)
+{
+	check(InPos >= 0 && InPos <= Size);
+
+	FlushChunk();
+	Pos = InPos;
+	ChunkOffset = Pos;
+}
+
+void FSaveGameFileWriter::EndSmallWrites()
+{
+	if (!SmallWrites.IsEmpty())
+	{
+		Chunk.Add(MakeSharedBufferFromArray(MoveTemp(SmallWrites)));
+		SmallWrites.Reset();
+	}
+}
+
+void FSaveGameFileWriter::FlushChunk()
+{
+	EndSmallWrites();
+
+	if (!Chunk.IsEmpty())
+	{
+		IoPipe.Launch(UE_SOURCE_LOCATION, [this, Offset = ChunkOffset, Num = ChunkNum, Buffers = MoveTemp(Chunk)]
+		{
+			QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_WriteChunk);
+
+			if (bWriteFailed)
+			{
+				return;
+			}
+
+			// IFileHandle has no vectored writes, so the buffers are written one after another where they are
+			bool bWritten = Handle->Tell() == Offset || Handle->Seek(Offset);
+
+			for (int32 Idx = 0; bWritten && Idx < Buffers.Num(); ++Idx)
+			{
+				bWritten = Handle->Write(static_cast<const uint8*>(Buffers[Idx].GetData()), Buffers[Idx].GetSize());
+			}
+
+			if (!bWritten)
+			{
+				UE_LOG(LogSaveGameFileWriter, Error, TEXT("Couldn't write %lld bytes at %lld of %s"),
+				       Num, Offset, *TempFilePath);
+				bWriteFailed = true;
+			}
+		}, UE::Tasks::ETaskPriority::BackgroundHigh);
+
+		Chunk.Reset();
+	}
+
+	ChunkOffset = Pos;
+	ChunkNum = 0;
+}
+
+UE::Tasks::TTask<bool> FSaveGameFileWriter::Commit()
+{
+	check(!bCommitted);
+
+	if (IsError())
+	{
+		bCommitted = true;
+		return UE::Tasks::MakeCompletedTask<bool>(false);
+	}
+
+	FlushChunk();
+	bCommitted = true;
+
+	return IoPipe.Launch(UE_SOURCE_LOCATION, [this]
+	{
+		bool bWritten = !bWriteFailed && Handle->Flush();
+		Handle.Reset();
+
+		// Only replace the previous file once the new one has been completely written
+		bWritten = bWritten && IFileManager::Get().Move(*FilePath, *TempFilePath);
+
+		if (!bWritten)
+		{
+			UE_LOG(LogSaveGameFileWriter, Error, TEXT("Couldn't write %s"), *FilePath);
+			IFileManager::Get().Delete(*TempFilePath);
+		}
+
+		return bWritten;
+	}, UE::Tasks::ETaskPriority::BackgroundHigh);
+}
@@ -4,6 +4,8 @@
 
 #include "SaveGameSettings.h"
 #include "SaveGameThreading.h"
+#include "SaveGameTransform.h"
+#include "SaveGameVersion.h"
 #include "Formatters/JsonOutputArchiveFormatter.h"
 
 #if WITH_EDITOR
@@ -61,7 +63,10 @@ bool USaveGameFunctionLibrary::SerializeActorTransform(FSaveGameArchive& Archive
 	if (Archive.IsValid() && IsValid(Actor))
 	{
 		const bool bIsMovable = Actor->IsRootComponentMovable();
-		const bool bIsLoading = Archive.GetRecord().GetUnderlyingArchive().IsLoading();
+		const FArchive& UnderlyingArchive = Archive.GetRecord().GetUnderlyingArchive();
+		const bool bIsLoading = UnderlyingArchive.IsLoading();
+		const bool bQuantized = !bIsLoading
+			|| UnderlyingArchive.CustomVer(FSaveGameVersion::GUID) >= FSaveGameVersion::QuantizedTransforms;
 
 		// Save into a slot only if the actor is movable
 		return (bIsLoading || bIsMovable) && Archive.SerializeField(TEXT("ActorTransform"), [&](FStructuredArchive::FSlot Slot)
@@ -74,29 +79,28 @@ bool USaveGameFunctionLibrary::SerializeActorTransform(FSaveGameArchive& Archive
 			}
 
 			// ObjSerialize the transform
-			Slot << ActorTransform;
+			if (bQuantized)
+			{
+				FSaveGameTransform::Serialize(Slot, ActorTransform);
+			}
+			else
+			{
+				Slot << ActorTransform;
+			}
 
 			if (bIsLoading && bIsMovable)
 			{
-				auto SetActorTransform = [Actor = TWeakObjectPtr<AActor>(Actor), ActorTransform]
+				if (IsInGameThread())
 				{
 					QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SetActorTransform);
 
-					// If the actor is movable, set its transform
-					if (Actor.IsValid())
-					{
-						Actor->SetActorTransform(ActorTransform, false, nullptr, ETeleportType::TeleportPhysics);
-					}
-				};
-
-				if (IsInGameThread())
-				{
-					// We're already in the game thread, execute immediately
-					SetActorTransform();
+					// We're already in the game thread, so set the transform immediately
+					Actor->SetActorTransform(ActorTransform, false, nullptr, ETeleportType::TeleportPhysics);
 				}
 				else
 				{
-					ISaveGameThreadQueue::Get().AddTask(Forward<ISaveGameThreadQueue::FTaskFunction>(SetActorTransform));
+					// Set along with the transforms that were loaded alongside it, in its place in the queue
+					ISaveGameThreadQueue::Get().AddTransform(Actor, ActorTransform);
 				}
 			}
 		});
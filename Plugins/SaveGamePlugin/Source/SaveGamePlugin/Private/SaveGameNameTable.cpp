@@ -0,0 +1,205 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "SaveGameNameTable.h"
+
+#include "SaveGameContainer.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSaveGameNameTable, Log, All);
+
+uint32 FSaveGameNameTable::AddName(FName Name)
+{
+	return NameIndices.FindOrAdd(Name, [this, Name]
+	{
+		FScopeLock Lock(&NamesLock);
+		return static_cast<uint32>(Names.Add(Name));
+	});
+}
+
+uint32 FSaveGameNameTable::AddPath(const FSoftObjectPath& Path)
+{
+	return PathIndices.FindOrAdd(Path, [this, &Path]
+	{
+		// Added first, so that the table has every name that its paths reference
+		AddName(Path.GetAssetPath().GetPackageName());
+		AddName(Path.GetAssetPath().GetAssetName());
+
+		FScopeLock Lock(&PathsLock);
+		return static_cast<uint32>(Paths.Add(Path));
+	});
+}
+
+uint32 FSaveGameNameTable::AddObject(const UObject* Object)
+{
+	return ObjectIndices.FindOrAdd(FObjectKey(Object), [this, Object]
+	{
+		return AddObjectPath(FSoftObjectPath(Object));
+	});
+}
+
+uint32 FSaveGameNameTable::AddObjectPath(const FSoftObjectPath& Path)
+{
+	const uint32 Index = AddPath(Path);
+
+	FScopeLock Lock(&PathsLock);
+	if (!ObjectPaths.IsValidIndex(Index))
+	{
+		ObjectPaths.SetNum(Index + 1, false);
+	}
+
+	ObjectPaths[Index] = true;
+	return Index;
+}
+
+FName FSaveGameNameTable::GetName(uint32 Index) const
+{
+	if (!ensureMsgf(Names.IsValidIndex(Index), TEXT("Name %u isn't in the table"), Index))
+	{
+		return NAME_None;
+	}
+
+	return Names[Index];
+}
+
+const FSoftObjectPath& FSaveGameNameTable::GetPath(uint32 Index) const
+{
+	if (!ensureMsgf(Paths.IsValidIndex(Index), TEXT("Path %u isn't in the table"), Index))
+	{
+		static const FSoftObjectPath NullPath;
+		return NullPath;
+	}
+
+	return Paths[Index];
+}
+
+void FSaveGameNameTable::Reset()
+{
+	Names.Reset();
+	Paths.Reset();
+	ObjectPaths.Empty();
+	NameIndices.Reset();
+	PathIndices.Reset();
+	ObjectIndices.Reset();
+}
+
+void FSaveGameNameTable::Serialize(FArchive& Ar, int32 ContainerVersion)
+{
+	// Levels can be snapshotted on the game thread while a save is writing the table (see FSaveGamePendingLevel)
+	FScopeLock NamesScopeLock(&NamesLock);
+	FScopeLock PathsScopeLock(&PathsLock);
+
+	// Names are written as strings, as their indices in the name pool won't be the same when loading
+	int32 NumNames = Names.Num();
+	Ar << NumNames;
+
+	if (Ar.IsLoading())
+	{
+		Names.Reset(NumNames);
+	}
+
+	for (int32 NameIdx = 0; NameIdx < NumNames; ++NameIdx)
+	{
+		FString Name;
+
+		if (Ar.IsSaving())
+		{
+			Name = Names[NameIdx].ToString();
+		}
+
+		Ar << Name;
+
+		if (Ar.IsLoading())
+		{
+			// Indexed, as saves carry on with the table of a load that left levels pending
+			const uint32 Index = Names.Add(*Name);
+			NameIndices.FindOrAdd(Names[Index], [Index] { return Index; });
+		}
+	}
+
+	int32 NumPaths = Paths.Num();
+	Ar << NumPaths;
+
+	if (Ar.IsLoading())
+	{
+		Paths.Reset(NumPaths);
+	}
+
+	for (int32 PathIdx = 0; PathIdx < NumPaths; ++PathIdx)
+	{
+		uint32 PackageName = 0;
+		uint32 AssetName = 0;
+		FString SubPath;
+
+		if (Ar.IsSaving())
+		{
+			const FSoftObjectPath& Path = Paths[PathIdx];
+			// These were added along with the path, so they'll only be found
+			PackageName = AddName(Path.GetAssetPath().GetPackageName());
+			AssetName = AddName(Path.GetAssetPath().GetAssetName());
+			SubPath = Path.GetSubPathString();
+		}
+
+		Ar.SerializeIntPacked(PackageName);
+		Ar.SerializeIntPacked(AssetName);
+		Ar << SubPath;
+
+		if (Ar.IsLoading())
+		{
+			const uint32 Index = Paths.Emplace(FTopLevelAssetPath(GetName(PackageName), GetName(AssetName)),
+			                                   MoveTemp(SubPath));
+			PathIndices.FindOrAdd(Paths[Index], [Index] { return Index; });
+		}
+	}
+
+	if (ContainerVersion >= FSaveGameContainer::ObjectReferences)
+	{
+		// Stored as the distance from the previous object path, as most paths of a save are object paths
+		uint32 NumObjectPaths = 0;
+
+		if (Ar.IsSaving())
+		{
+			ObjectPaths.SetNum(NumPaths, false);
+			NumObjectPaths = ObjectPaths.CountSetBits();
+		}
+		else
+		{
+			ObjectPaths.Init(false, NumPaths);
+		}
+
+		Ar.SerializeIntPacked(NumObjectPaths);
+
+		if (Ar.IsSaving())
+		{
+			int32 PreviousIdx = 0;
+			for (TConstSetBitIterator<> It(ObjectPaths); It; ++It)
+			{
+				uint32 Delta = It.GetIndex() - PreviousIdx;
+				Ar.SerializeIntPacked(Delta);
+				PreviousIdx = It.GetIndex();
+			}
+		}
+		else
+		{
+			int64 PathIdx = 0;
+			for (uint32 Idx = 0; Idx < NumObjectPaths && !Ar.IsError(); ++Idx)
+			{
+				uint32 Delta = 0;
+				Ar.SerializeIntPacked(Delta);
+				PathIdx += Delta;
+
+				if (!ObjectPaths.IsValidIndex(PathIdx))
+				{
+					Ar.SetError();
+					break;
+				}
+
+				ObjectPaths[PathIdx] = true;
+			}
+		}
+	}
+
+	if (Ar.IsError())
+	{
+		UE_LOG(LogSaveGameNameTable, Error, TEXT("Name table is corrupt"));
+		Reset();
+	}
+}
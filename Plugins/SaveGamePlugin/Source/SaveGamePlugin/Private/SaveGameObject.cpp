@@ -2,6 +2,54 @@
 
 #include "SaveGameObject.h"
 
+#include "SaveGameVersion.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/ObjectKey.h"
+
+/**
+ * The CoreRedirected names of each class's fields. Walking the class hierarchy for every field of every loaded object
+ * adds up, so each class and field name is only resolved once.
+ */
+class FSaveGameFieldRedirects
+{
+public:
+	FName Resolve(const UClass* Class, FName FieldName)
+	{
+		const TPair<FObjectKey, FName> Key(Class, FieldName);
+
+		{
+			FReadScopeLock ReadLock(Lock);
+			if (const FName* Resolved = Redirects.Find(Key))
+			{
+				return *Resolved;
+			}
+		}
+
+		FName Resolved = FieldName;
+
+		for (const UStruct* CheckStruct = Class; CheckStruct; CheckStruct = CheckStruct->GetSuperStruct())
+		{
+			const FName NewProperty = FProperty::FindRedirectedPropertyName(CheckStruct, FieldName);
+
+			if (!NewProperty.IsNone())
+			{
+				Resolved = NewProperty;
+				break;
+			}
+		}
+
+		FWriteScopeLock WriteLock(Lock);
+		Redirects.Add(Key, Resolved);
+		return Resolved;
+	}
+
+private:
+	FRWLock Lock;
+	TMap<TPair<FObjectKey, FName>, FName> Redirects;
+};
+
+static FSaveGameFieldRedirects GFieldRedirects;
+
 FSaveGameArchive::FSaveGameArchive(FStructuredArchive::FRecord& InRecord, UObject* InObject)
 	: Record(&InRecord)
 	, Object(InObject)
@@ -21,36 +69,65 @@ FSaveGameArchive::FSaveGameArchive(FStructuredArchive::FRecord& InRecord, UObjec
 
 	StartPosition = Archive.Tell();
 
-	// If saving, pre-fill this so that we can fill it on destruct
-	// If loading, use it to immediately serialize our Fields map
-	uint64 FieldsOffset;
-	Archive << FieldsOffset;
-
-	if (Archive.IsLoading())
+	if (Archive.IsLoading() && Archive.CustomVer(FSaveGameVersion::GUID) < FSaveGameVersion::FieldDirectory)
+	{
+		SerializeLegacyFields(Archive);
+	}
+	else
 	{
-		// Go to our fields
-		Archive.Seek(StartPosition + FieldsOffset);
+		// If saving, pre-fill this so that we can fill it on destruct
+		// If loading, use it to immediately serialize our field directory
+		uint32 FieldsOffset = 0;
+		Archive << FieldsOffset;
+
+		if (Archive.IsLoading())
+		{
+			// Go to our fields
+			Archive.Seek(StartPosition + FieldsOffset);
+
+			uint32 NumFields = 0;
+			Archive.SerializeIntPacked(NumFields);
 
-		// Serialize them in
-		Archive << Fields;
+			// Don't trust a count with more fields than there are bytes left
+			if (NumFields > Archive.TotalSize() - Archive.Tell())
+			{
+				// We'll still seek to our end position as we destruct, which may as well be where we got to
+				EndPosition = Archive.Tell();
+				Archive.SetError();
+				return;
+			}
+
+			Fields.Reserve(NumFields);
+
+			// Offsets are stored as the difference from the previous field's, as fields are saved in order
+			uint32 FieldOffset = 0;
 
+			for (uint32 FieldIdx = 0; FieldIdx < NumFields && !Archive.IsError(); ++FieldIdx)
+			{
+				FName FieldName;
+				uint32 OffsetDelta = 0;
+				Archive << FieldName;
+				Archive.SerializeIntPacked(OffsetDelta);
+
+				FieldOffset += OffsetDelta;
+				Fields.Emplace(FieldName, FieldOffset);
+			}
+		}
+	}
+
+	if (Archive.IsLoading())
+	{
 		// Store our true end position, so that when we destruct, we can fall off the end gracefully
 		EndPosition = Archive.Tell();
 
 		// If we have any properties that were redirected in CoreRedirects, fix them here
-		for (auto It = Fields.CreateIterator(); It; ++It)
+		if (const UObject* ResolvedObject = Object.Get())
 		{
-			TPair<FName, uint64>& Field = *It;
+			const UClass* Class = ResolvedObject->GetClass();
 
-			for (UStruct* CheckStruct = Object->GetClass(); CheckStruct; CheckStruct = CheckStruct->GetSuperStruct())
+			for (TPair<FName, uint32>& Field : Fields)
 			{
-				FName NewProperty = FProperty::FindRedirectedPropertyName(CheckStruct, Field.Key);
-
-				if (!NewProperty.IsNone())
-				{
-					Field.Key = NewProperty;
-					break;
-				}
+				Field.Key = GFieldRedirects.Resolve(Class, Field.Key);
 			}
 		}
 	}
@@ -58,7 +135,7 @@ FSaveGameArchive::FSaveGameArchive(FStructuredArchive::FRecord& InRecord, UObjec
 
 FSaveGameArchive::~FSaveGameArchive()
 {
-	// We're going out of scope, let's serialize our fields map
+	// We're going out of scope, let's serialize our field directory
 	if (!IsValid())
 	{
 		return;
@@ -78,14 +155,26 @@ FSaveGameArchive::~FSaveGameArchive()
 
 	if (Archive.IsSaving())
 	{
-		uint64 FieldsOffset = Archive.Tell() - StartPosition;
+		uint32 FieldsOffset = IntCastChecked<uint32>(Archive.Tell() - StartPosition);
 
 		// Store our accrued list of fields and their offsets
-		Archive << Fields;
+		uint32 NumFields = Fields.Num();
+		Archive.SerializeIntPacked(NumFields);
+
+		uint32 PreviousOffset = 0;
+
+		for (TPair<FName, uint32>& Field : Fields)
+		{
+			uint32 OffsetDelta = Field.Value - PreviousOffset;
+			Archive << Field.Key;
+			Archive.SerializeIntPacked(OffsetDelta);
+
+			PreviousOffset = Field.Value;
+		}
 
 		EndPosition = Archive.Tell();
 
-		// Store the offset to our fields map
+		// Store the offset to our field directory
 		Archive.Seek(StartPosition);
 		Archive << FieldsOffset;
 	}
@@ -93,3 +182,21 @@ FSaveGameArchive::~FSaveGameArchive()
 	// If we had any ordering changes or removals of fields, be sure to continue on from the very end
 	Archive.Seek(EndPosition);
 }
+
+void FSaveGameArchive::SerializeLegacyFields(FArchive& Archive)
+{
+	uint64 FieldsOffset;
+	Archive << FieldsOffset;
+
+	Archive.Seek(StartPosition + FieldsOffset);
+
+	TMap<FName, uint64> LegacyFields;
+	Archive << LegacyFields;
+
+	Fields.Reserve(LegacyFields.Num());
+
+	for (const TPair<FName, uint64>& Field : LegacyFields)
+	{
+		Fields.Emplace(Field.Key, IntCastChecked<uint32>(Field.Value));
+	}
+}
@@ -4,83 +4,120 @@
 
 #include "SaveGameSerializer.h"
 
+#include "SaveGameCompression.h"
 #include "SaveGameFunctionLibrary.h"
 #include "SaveGameObject.h"
 #include "SaveGameVersion.h"
 #include "SaveGameProxyArchive.h"
 #include "TaskHelpers.inl"
-#include "Formatters/NullArchiveFormatter.h"
 
 constexpr bool bForceSingleThreaded = false;
 #define USE_TEXT_FORMATTER WITH_TEXT_ARCHIVE_SUPPORT
 
+/** Logs every formatter call of every archive, for debugging the structure of the save data */
+#define USE_TRACING_FORMATTER 0
+
 #if USE_TEXT_FORMATTER
 #include "Formatters/JsonOutputArchiveFormatter.h"
-#include "Formatters/ProxyArchiveFormatter.h"
+#include "Formatters/TeeArchiveFormatter.h"
+#endif
+
+#if USE_TRACING_FORMATTER
+#include "Formatters/TracingArchiveFormatter.h"
 #endif
 
 #include "SaveGameSystem.h"
 #include "PlatformFeatures.h"
+#include "SaveGameSettings.h"
 #include "SaveGameSubsystem.h"
 #include "SaveGameThreading.h"
+#include "Algo/AnyOf.h"
+#include "Containers/Ticker.h"
+#include "Misc/Paths.h"
+#include "UObject/GarbageCollection.h"
+#include "UObject/GCObject.h"
 #include "Tasks/TaskConcurrencyLimiter.h"
 
 #define LEVEL_SUBPATH_PREFIX TEXT("PersistentLevel.")
 
+DEFINE_LOG_CATEGORY_STATIC(LogSaveGameSerializer, Log, All);
+
 using namespace UE::Tasks;
 
 #if USE_TEXT_FORMATTER
-class FSaveGameArchiveFormatter : public FProxyArchiveFormatter
+static int32 GJsonOutputInterval = 0;
+static FAutoConsoleVariableRef CVarJsonOutputInterval(
+	TEXT("SaveGame.JsonOutputInterval"),
+	GJsonOutputInterval,
+	TEXT("Writes a (compact, not pretty-printed) JSON copy of every Nth save next to it, for debugging. 0 disables it,")
+	TEXT(" 1 writes one for every save."));
+#endif
+
+/** Whether the next save also writes a JSON copy of itself, see SaveGame.JsonOutputInterval */
+static bool ShouldWriteJsonOutput()
 {
-public:
-	FSaveGameArchiveFormatter(FArchive& InnerArchive, bool bUseNull)
-		: FProxyArchiveFormatter(BinaryFormatter,
-		                         static_cast<FStructuredArchiveFormatter&>(bUseNull
-			                                                                   ? FNullArchiveFormatter::Get()
-			                                                                   : JsonFormatter))
-		  , BinaryFormatter(InnerArchive)
+#if USE_TEXT_FORMATTER
+	check(IsInGameThread());
+
+	static int32 NumSaves = 0;
+	return GJsonOutputInterval > 0 && NumSaves++ % GJsonOutputInterval == 0;
+#else
+	return false;
+#endif
+}
+
+#if USE_TEXT_FORMATTER
+/** Writes the JSON output of a save alongside its binary data */
+struct FSaveGameJsonOutput
+{
+	explicit FSaveGameJsonOutput(FBinaryArchiveFormatter& BinaryFormatter)
+		: TeeFormatter(BinaryFormatter, JsonFormatter)
 	{
 	}
 
-	FBinaryArchiveFormatter BinaryFormatter;
 	FJsonOutputArchiveFormatter JsonFormatter;
+	TTeeArchiveFormatter<FBinaryArchiveFormatter, FJsonOutputArchiveFormatter> TeeFormatter;
 };
 #endif
 
+/**
+ * Loads, and saves without JSON output, go straight to the binary formatter. Saves with JSON output go through a tee
+ * to the binary and JSON formatters.
+ */
 template <bool bIsLoading>
 class TSaveGameArchive
 {
-	using FSaveGameFormatter = std::conditional_t<USE_TEXT_FORMATTER, class FSaveGameArchiveFormatter, FBinaryArchiveFormatter>;
-
 public:
-	TSaveGameArchive(FArchive& InArchive, TMap<FSoftObjectPath, FSoftObjectPath>& InRedirects)
-		: ProxyArchive(InArchive, InRedirects)
-		  , Formatter(ProxyArchive, bIsLoading)
-		  , ArchiveData(nullptr)
+	TSaveGameArchive(FArchive& InArchive, FSaveGameRedirects& InRedirects, FSaveGameNameTable* InNameTable,
+	                 bool bJsonOutput = false)
+		: ProxyArchive(InArchive, InRedirects, InNameTable)
+		  , BinaryFormatter(ProxyArchive)
 	{
+#if USE_TEXT_FORMATTER
+		if (!bIsLoading && bJsonOutput)
+		{
+			JsonOutput.Emplace(BinaryFormatter);
+		}
+#endif
 	}
 
 	~TSaveGameArchive()
 	{
-		checkf(ArchiveData == nullptr, TEXT("Be sure to manually close archive!"));
+		checkf(!ArchiveData.IsSet(), TEXT("Be sure to manually close archive!"));
 	}
 
 	FStructuredArchive::FRecord& GetRecord()
 	{
-		if (ArchiveData == nullptr)
+		if (!ArchiveData.IsSet())
 		{
-			ArchiveData = new FStructuredArchiveData(Formatter);
+			ArchiveData.Emplace(GetFormatter());
 		}
 		return ArchiveData->RootRecord;
 	}
 
 	void Close()
 	{
-		if (ArchiveData)
-		{
-			delete ArchiveData;
-			ArchiveData = nullptr;
-		}
+		ArchiveData.Reset();
 	}
 
 	void ConsolidateVersions(TSaveGameArchive& Other)
@@ -93,26 +130,61 @@ public:
 		}
 		else
 		{
-			const FCustomVersionContainer& OtherVersions = Other.ProxyArchive.GetCustomVersions();
+			ConsolidateVersions(Other.ProxyArchive.GetCustomVersions());
+		}
+	}
 
-			for (const FCustomVersion& Version : ProxyArchive.GetCustomVersions().GetAllVersions())
-			{
-				const FCustomVersion* OtherVersion = OtherVersions.GetVersion(Version.Key);
-				check(OtherVersion == nullptr || Version.Version == OtherVersion->Version);
-				Other.ProxyArchive.SetCustomVersion(Version.Key, Version.Version, Version.GetFriendlyName());
-			}
+	/** When saving, merges the versions used by another archive (or a cached actor) into this archive */
+	void ConsolidateVersions(const FCustomVersionContainer& OtherVersions)
+	{
+		check(!bIsLoading);
+
+		for (const FCustomVersion& Version : OtherVersions.GetAllVersions())
+		{
+			const FCustomVersion* OurVersion = ProxyArchive.GetCustomVersions().GetVersion(Version.Key);
+			check(OurVersion == nullptr || Version.Version == OurVersion->Version);
+			ProxyArchive.SetCustomVersion(Version.Key, Version.Version, Version.GetFriendlyName());
 		}
 	}
 
 	TSaveGameProxyArchive<bIsLoading>& GetArchive() { return ProxyArchive; }
 
+#if USE_TEXT_FORMATTER
+	/** The formatter of our JSON output, null if we don't have any */
+	FJsonOutputArchiveFormatter* GetJsonFormatter() { return JsonOutput ? &JsonOutput->JsonFormatter : nullptr; }
+#endif
+
 private:
+	FStructuredArchiveFormatter& GetFormatter()
+	{
+		FStructuredArchiveFormatter* Formatter = &BinaryFormatter;
+
+#if USE_TEXT_FORMATTER
+		if (JsonOutput)
+		{
+			Formatter = &JsonOutput->TeeFormatter;
+		}
+#endif
+
+#if USE_TRACING_FORMATTER
+		TracingFormatter.Emplace(*Formatter);
+		Formatter = &TracingFormatter.GetValue();
+#endif
+
+		return *Formatter;
+	}
+
 	TSaveGameProxyArchive<bIsLoading> ProxyArchive;
+	FBinaryArchiveFormatter BinaryFormatter;
 
-public:
-	FSaveGameFormatter Formatter;
+#if USE_TEXT_FORMATTER
+	TOptional<FSaveGameJsonOutput> JsonOutput;
+#endif
+
+#if USE_TRACING_FORMATTER
+	TOptional<FTracingArchiveFormatter> TracingFormatter;
+#endif
 
-private:
 	struct FStructuredArchiveData
 	{
 		FStructuredArchiveData(FStructuredArchiveFormatter& InFormatter)
@@ -127,614 +199,2411 @@ private:
 		FStructuredArchive::FRecord RootRecord;
 	};
 
-	FStructuredArchiveData* ArchiveData;
+	/** Held inline, as there's one of these per actor */
+	TOptional<FStructuredArchiveData> ArchiveData;
 };
 
-template <bool bLoading>
-FORCEINLINE_DEBUGGABLE void SerializeCompressedData(FArchive& Ar, TArray<uint8>& Data)
+/** A memory writer over any byte array, so that actors can write to arrays that are allocated in the arena */
+template <typename ArrayType>
+class TSaveGameMemoryWriter final : public FMemoryArchive
 {
-	check(Ar.IsLoading() == bLoading);
-
-	int64 UncompressedSize;
+public:
+	explicit TSaveGameMemoryWriter(ArrayType& InBytes)
+		: Bytes(InBytes)
+	{
+		SetIsSaving(true);
+	}
 
-	if (!bLoading)
+	virtual void Serialize(void* Data, int64 Num) override
 	{
-		UncompressedSize = Data.Num();
+		const int64 NumBytesToAdd = Offset + Num - Bytes.Num();
+		if (NumBytesToAdd > 0)
+		{
+			Bytes.AddUninitialized(IntCastChecked<int32>(NumBytesToAdd));
+		}
+
+		if (Num > 0)
+		{
+			FMemory::Memcpy(Bytes.GetData() + Offset, Data, Num);
+			Offset += Num;
+		}
 	}
 
-	Ar << UncompressedSize;
+	virtual int64 TotalSize() override { return Bytes.Num(); }
+	virtual FString GetArchiveName() const override { return TEXT("TSaveGameMemoryWriter"); }
 
-	if (bLoading)
+private:
+	ArrayType& Bytes;
+};
+
+/**
+ * Where a class's SaveGame properties are, which is all that the snapshots of its actors hold. A snapshot only holds
+ * the range of the class's memory from its first SaveGame property to the end of its last, which is usually a small
+ * part of it, as SaveGame properties are declared together by the classes that save them (rather than by AActor).
+ */
+class FSaveGamePropertySnapshotLayout : public FNoncopyable
+{
+public:
+	explicit FSaveGamePropertySnapshotLayout(const UClass* Class)
+		: Alignment(Class->GetMinAlignment())
 	{
-		Data.SetNumUninitialized(UncompressedSize);
+		int32 Start = MAX_int32;
+
+		for (TFieldIterator<FProperty> It(Class); It; ++It)
+		{
+			const FProperty* Property = *It;
+			if (!Property->HasAnyPropertyFlags(CPF_SaveGame))
+			{
+				continue;
+			}
+
+			Properties.Add(Property);
+			Start = FMath::Min(Start, Property->GetOffset_ForInternal());
+			End = FMath::Max(End, Property->GetOffset_ForInternal() + Property->GetSize());
+
+			TArray<const FStructProperty*> EncounteredStructProps;
+			if (Property->ContainsObjectReference(EncounteredStructProps))
+			{
+				ReferenceProperties.Add(Property);
+			}
+		}
+
+		// Aligned like the class, so that each property is aligned as it is in the actor
+		Offset = Properties.IsEmpty() ? 0 : AlignDown(Start, Alignment);
+		End = FMath::Max(End, Offset);
 	}
 
-	Ar.SerializeCompressed(Data.GetData(), UncompressedSize, NAME_Zlib);
-}
+	/** The class's SaveGame properties, and those of them that reference objects */
+	TArray<const FProperty*> Properties;
+	TArray<const FProperty*> ReferenceProperties;
 
-template <bool bIsLoading>
-struct TSaveGameSerializer<bIsLoading>::FActorInfo
+	/** The range of the class's memory that a snapshot holds */
+	int32 Offset = 0;
+	int32 End = 0;
+	int32 Alignment;
+};
+
+/**
+ * A copy of an actor's SaveGame properties, taken on the game thread so that they can be serialized on a task worker
+ * while the game carries on. The copy is addressed like the actor (see FSaveGamePropertySnapshotLayout), so it
+ * serializes exactly as the actor would have, though only its SaveGame properties can be read. That's all that our
+ * archives (which are save game archives, see FArchive::IsSaveGame) serialize. Object references are copied as is,
+ * they're kept alive by the serializer (see FSnapshotReferencer), and are resolved to paths when serialized.
+ */
+class FSaveGamePropertySnapshot : public FNoncopyable
 {
-	~FActorInfo()
+public:
+	FSaveGamePropertySnapshot(const AActor* Actor, const FSaveGamePropertySnapshotLayout& InLayout,
+	                          FSaveGameArena& Arena)
+		: Layout(InLayout)
+		  , Class(Actor->GetClass())
+		  , Archetype(Actor->GetArchetype())
 	{
-		if (Archive)
+		uint8* Buffer = static_cast<uint8*>(Arena.Malloc(FMath::Max(Layout.End - Layout.Offset, 1), Layout.Alignment));
+
+		// Offset, so that each property is where it would be in the actor
+		Memory = Buffer - Layout.Offset;
+
+		for (const FProperty* Property : Layout.Properties)
 		{
-			delete Archive;
-			Archive = nullptr;
+			void* Value = Property->ContainerPtrToValuePtr<void>(Memory);
+			Property->InitializeValue(Value);
+			Property->CopyCompleteValue(Value, Property->ContainerPtrToValuePtr<void>(Actor));
 		}
+	}
 
-		if (MemoryArchive)
+	~FSaveGamePropertySnapshot()
+	{
+		// The memory itself belongs to the arena
+		for (const FProperty* Property : Layout.Properties)
 		{
-			delete MemoryArchive;
-			MemoryArchive = nullptr;
+			Property->DestroyValue(Property->ContainerPtrToValuePtr<void>(Memory));
 		}
 	}
 
-	void CreateArchive(TArray<uint8>& InData, TMap<FSoftObjectPath, FSoftObjectPath>& InRedirects)
+	/** Serializes the copied properties, as UObject::SerializeScriptProperties would have */
+	void Serialize(FStructuredArchive::FSlot Slot) const
 	{
-		MemoryArchive = new TSaveGameMemoryArchive(InData);
-		Archive = new TSaveGameArchive<bIsLoading>(*MemoryArchive, InRedirects);
+		Class->SerializeTaggedProperties(Slot, Memory, Class, reinterpret_cast<uint8*>(Archetype.Get()));
 	}
 
-	TWeakObjectPtr<AActor> Actor;
-	FString Name;
-	TArray<uint8> Data;
-	TSaveGameArchive<bIsLoading>* Archive = nullptr;
+	void AddReferencedObjects(FReferenceCollector& Collector)
+	{
+		Collector.AddReferencedObject(Class);
+		Collector.AddReferencedObject(Archetype);
+
+		// Only our properties are in our memory, so the class's reference schema can't be used. The properties that
+		// reference objects are serialized to the collector instead, which is slow, but only happens while we're saving
+		if (!Layout.ReferenceProperties.IsEmpty())
+		{
+			FStructuredArchiveFromArchive Ar(Collector.GetVerySlowReferenceCollectorArchive());
+			FStructuredArchive::FStream Stream = Ar.GetSlot().EnterStream();
+
+			for (const FProperty* Property : Layout.ReferenceProperties)
+			{
+				for (int32 ArrayIdx = 0; ArrayIdx < Property->ArrayDim; ++ArrayIdx)
+				{
+					Property->SerializeItem(Stream.EnterElement(),
+					                        Property->ContainerPtrToValuePtr<void>(Memory, ArrayIdx));
+				}
+			}
+		}
+	}
+
+	UClass* GetClass() const { return Class; }
+	const UObject* GetArchetype() const { return Archetype; }
+
+	/** The copied properties, addressed like the actor. Only SaveGame properties can be read from it */
+	uint8* GetMemory() const { return Memory; }
 
 private:
-	FArchive* MemoryArchive = nullptr;
+	const FSaveGamePropertySnapshotLayout& Layout;
+	TObjectPtr<UClass> Class;
+	TObjectPtr<UObject> Archetype;
+	uint8* Memory;
 };
 
+/**
+ * An actor's archives (and the memory archives beneath them) are created in the serializer's arena, which releases
+ * them in one go once the operation has finished.
+ */
 template <bool bIsLoading>
-TSaveGameSerializer<bIsLoading>::TSaveGameSerializer(USaveGameSubsystem* InSubsystem, FString SaveName)
-	: Subsystem(InSubsystem)
-	  , Archive(Data)
-	  , SaveArchive(new TSaveGameArchive<bIsLoading>(Archive, Redirects))
-	  , ActorOffsetsOffset(0)
-	  , VersionOffset(0)
-	  , ActorsOffset(0)
-	  , SaveName(MoveTemp(SaveName))
+struct TSaveGameSerializer<bIsLoading>::FActorInfo
 {
-	// Ensure that we're using the latest save game version
-	Archive.UsingCustomVersion(FSaveGameVersion::GUID);
-}
+	~FActorInfo()
+	{
+		ReleaseCustomData();
+	}
 
-template <bool bIsLoading>
-TSaveGameSerializer<bIsLoading>::~TSaveGameSerializer()
-{
-	delete SaveArchive;
-}
+	template <typename ArrayType>
+	void CreateArchive(FSaveGameArena& Arena, ArrayType& InData, FSaveGameRedirects& InRedirects,
+	                   FSaveGameNameTable* InNameTable, bool bJsonOutput = false)
+	{
+		Archive = CreateArchive(Arena, InData, InRedirects, InNameTable, bJsonOutput, MemoryArchive);
+	}
 
-template <bool bIsLoading>
-FTask TSaveGameSerializer<bIsLoading>::DoOperation()
-{
-	if (ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem())
+	void CreateCustomDataArchive(FSaveGameArena& Arena, FSaveGameRedirects& InRedirects,
+	                             FSaveGameNameTable* InNameTable, bool bJsonOutput)
 	{
-		FTask PreviousTask;
+		CustomDataArchive = CreateArchive(Arena, CustomData, InRedirects, InNameTable, bJsonOutput,
+		                                  CustomDataMemoryArchive);
+	}
 
-		if (bIsLoading)
+	/** Releases the custom data, once it has been spliced into this actor's data */
+	void ReleaseCustomData()
+	{
+		if (CustomDataArchive)
 		{
-			PreviousTask = Launch(UE_SOURCE_LOCATION, [this, SaveSystem]
-			{
-				TArray<uint8> CompressedData;
-				const bool bLoaded = SaveSystem->LoadGame(false, *GetSaveName(), 0, CompressedData);
-				check(bLoaded);
-
-				// Decompress the loaded save game data
-				TSaveGameMemoryArchive CompressorArchive(CompressedData);
-				SerializeCompressedData<true>(CompressorArchive, Data);
-			}, PreviousTask);
+			CustomDataArchive->Close();
+			CustomDataArchive = nullptr;
+			CustomDataMemoryArchive = nullptr;
 		}
 
-		PreviousTask = Launch(UE_SOURCE_LOCATION, [this]
-		{
-			SerializeVersionOffset();
-			SerializeHeader();
-		}, PreviousTask);
+		CustomData.Empty();
+	}
 
-		if (bIsLoading)
-		{
-			PreviousTask = Launch(UE_SOURCE_LOCATION, [this] { SerializeVersions(); }, PreviousTask);
+	TWeakObjectPtr<AActor> Actor;
+	FString Name;
+	FSaveGameArenaArray Data;
+	TSaveGameArchive<bIsLoading>* Archive = nullptr;
 
-			FTaskEvent MapLoadEvent(TEXT("MapLoaded"));
-			LaunchGameThread(UE_SOURCE_LOCATION, [this, MapLoadEvent]() mutable
-			{
-				UWorld* World = Subsystem->GetWorld();
+	/** The class of a spawned actor, null for level actors */
+	FSoftClassPath Class;
 
-				check(!LastVisitedMap.IsEmpty());
-				check(!World->IsInSeamlessTravel());
+	/** Set if this is an ISaveGameSpawnActor, that needs to be mapped by SpawnID */
+	FGuid SpawnID;
 
-				// When our map has loaded, continue the serialization process
-				FCoreUObjectDelegates::PostLoadMapWithWorld.AddSPLambda(this, [this, MapLoadEvent](UWorld*) mutable
-				{
-					MapLoadEvent.Trigger();
+	/** When saving, a copy of this actor's SaveGame properties, which is serialized off the game thread */
+	TOptional<FSaveGamePropertySnapshot> Snapshot;
 
-					const signed int RemovedCount = FCoreUObjectDelegates::PostLoadMapWithWorld.RemoveAll(this);
-					check(RemovedCount == 1);
-				});
+	/** When saving, the data written by OnSerialize when the snapshot was taken, spliced into Data once serialized */
+	FSaveGameArenaArray CustomData;
+	TSaveGameArchive<bIsLoading>* CustomDataArchive = nullptr;
 
-				World->SeamlessTravel(LastVisitedMap, true);
-			}, PreviousTask);
+	/** Index of the level (in Levels) that this actor belongs to */
+	int32 LevelIdx = INDEX_NONE;
 
-			// Our next task should wait for the map to be loaded
-			PreviousTask = MapLoadEvent;
-		}
+	/** When saving, whether this actor was loaded with its level (rather than spawned) */
+	bool bLevelActor = false;
 
-		PreviousTask = LaunchGameThread(UE_SOURCE_LOCATION, [this]
-		{
-			SerializeDestroyedActors();
-			SerializeActors();
-		}, PreviousTask);
+	/** When saving, whether this actor's SaveGame properties are stored in its level's column group */
+	bool bColumnar = false;
 
-		if (!bIsLoading)
-		{
-			PreviousTask = Launch(UE_SOURCE_LOCATION, [this]
-			{
-				MergeSaveData();
-				SerializeVersions();
+	/** When loading, the offset of this actor's data in its level's data */
+	uint64 Offset = 0;
 
-				// Go back to the start to override the original version offset
-				Archive.Seek(0);
-				SerializeVersionOffset();
-			}, PreviousTask);
-		}
+	/** When saving incrementally, the hash of this actor's SaveGame state (unset if it can't be reused) */
+	TOptional<uint32> PropertyHash;
 
-		PreviousTask = Launch(UE_SOURCE_LOCATION, [this]
-		{
-			SaveArchive->Close();
-		}, PreviousTask);
+	/**
+	 * When saving incrementally, the data from the last save if this actor hasn't changed since. It's a copy, as the
+	 * subsystem's cache can be reset on the game thread while we're merging (see HandOffActorCache).
+	 */
+	TOptional<FSaveGameActorCache> Cache;
 
-		if (!bIsLoading)
+	/** Triggered once this actor has been serialized, so that its data can be merged */
+	FTaskEvent SerializedEvent{UE_SOURCE_LOCATION};
+
+private:
+	FArchive* MemoryArchive = nullptr;
+	FArchive* CustomDataMemoryArchive = nullptr;
+
+	template <typename ArrayType>
+	static TSaveGameArchive<bIsLoading>* CreateArchive(FSaveGameArena& Arena, ArrayType& InData,
+	                                                   FSaveGameRedirects& InRedirects, FSaveGameNameTable* InNameTable,
+	                                                   bool bJsonOutput, FArchive*& OutMemoryArchive)
+	{
+		if constexpr (bIsLoading)
+		{
+			OutMemoryArchive = Arena.Create<FMemoryReaderView>(MakeMemoryView(InData));
+		}
+		else
 		{
-			TArray<FTask, TFixedAllocator<1 + USE_TEXT_FORMATTER>> FinishEvents;
+			OutMemoryArchive = Arena.Create<TSaveGameMemoryWriter<ArrayType>>(InData);
+		}
+
+		return Arena.Create<TSaveGameArchive<bIsLoading>>(*OutMemoryArchive, InRedirects, InNameTable,
+		                                                  bJsonOutput);
+	}
+};
+
+/**
+ * The actors of a level that share a class, whose SaveGame properties are stored together rather than in each actor's
+ * record (see USaveGameSettings::ColumnGroupThreshold). Each column holds one property's values for every actor, so
+ * similar values sit together.
+ */
+template <bool bIsLoading>
+struct TSaveGameSerializer<bIsLoading>::FColumnGroup
+{
+	struct FColumn
+	{
+		FName Name;
+
+		/** The property's C++ type, so that a property that has since changed type isn't read as its old one */
+		FName Type;
+
+		/**
+		 * A record of which actors differ from their archetype and their values, written by an archive of its own, as
+		 * the values can only be read once the class has been resolved
+		 */
+		TArray<uint8> Values;
 
 #if USE_TEXT_FORMATTER
-			FinishEvents.Add(Launch(UE_SOURCE_LOCATION, [this, SaveSystem]
-			{
-				TArray<uint8> JsonData;
-				FMemoryWriter WriterArchive(JsonData);
-				TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<
-					TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&WriterArchive);
-				FJsonSerializer::Serialize(
-					reinterpret_cast<FSaveGameArchiveFormatter&>(SaveArchive->Formatter).JsonFormatter.GetRoot(),
-					Writer);
-
-				SaveSystem->SaveGame(false, *(GetSaveName() + TEXT(".json")), 0, JsonData);
-			}, PreviousTask));
+		/** When saving with JSON output, the JSON of the record in Values, which is spliced in its place */
+		TArray<uint8> Json;
 #endif
+	};
 
-			FinishEvents.Add(Launch(UE_SOURCE_LOCATION, [this, SaveSystem]
-			{
-				// Compress the save game data
-				TArray<uint8> CompressedData;
-				TSaveGameMemoryArchive CompressorArchive(CompressedData);
-				SerializeCompressedData<false>(CompressorArchive, Data);
+	FSoftClassPath Class;
 
-				const bool bSaved = SaveSystem->SaveGame(false, *GetSaveName(), 0, CompressedData);
-				check(bSaved);
-			}, PreviousTask));
+	/** When loading, the class of the group, which is resolved on the game thread */
+	UClass* ResolvedClass = nullptr;
 
-			PreviousTask = Launch(UE_SOURCE_LOCATION, []
-			{
-			}, Prerequisites(FinishEvents), ETaskPriority::Default, EExtendedTaskPriority::Inline);
-		}
+	/** The actors in this group, as indices into their level chunk's actors */
+	TArray<int32> Rows;
 
-		return PreviousTask;
-	}
+	/** The actors in this group, as indices into ActorData (INDEX_NONE if a row is out of range) */
+	TArray<int32> ActorIndices;
 
-	return MakeCompletedTask<void>();
-}
+	TArray<FColumn> Columns;
 
-template <bool bIsLoading>
-void TSaveGameSerializer<bIsLoading>::SerializeVersionOffset()
-{
-	// We're a binary archive, so let's serialize where the version is
-	// so that we can read it before loading anything
-	SaveArchive->GetRecord() << SA_VALUE(TEXT("VersionsOffset"), VersionOffset);
-}
+	/** When saving, the versions used by the columns, which are consolidated when the group is merged */
+	FCustomVersionContainer Versions;
+};
 
 template <bool bIsLoading>
-void TSaveGameSerializer<bIsLoading>::SerializeHeader()
+struct TSaveGameSerializer<bIsLoading>::FLevelInfo
 {
-	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SerializeHeader);
+	/** The resident level for this chunk, null if the level isn't currently loaded */
+	TWeakObjectPtr<ULevel> Level;
+	FTopLevelAssetPath LevelAssetPath;
 
-	FEngineVersion EngineVersion;
-	FPackageFileVersion PackageVersion;
-	FDateTime Timestamp;
+	/** Names of level actors (without the PersistentLevel prefix) that have been destroyed */
+	TArray<FName> DestroyedActors;
 
-	if (!bIsLoading)
-	{
-		EngineVersion = FEngineVersion::Current();
-		PackageVersion = GPackageFileUEVersion;
-		Timestamp = FDateTime::UtcNow();
-		Subsystem->SetLastSaveTimestamp(Timestamp);
-	}
+	/** Offsets of each actor's data, relative to the start of this level chunk */
+	TArray<uint32> ActorOffsets;
 
-	FStructuredArchive::FRecord& Record = SaveArchive->GetRecord();
+	/** The actors of this level that are stored in column groups */
+	TArray<FColumnGroup> ColumnGroups;
 
-	Record << SA_VALUE(TEXT("EngineVersion"), EngineVersion);
-	Record << SA_VALUE(TEXT("PackageVersion"), PackageVersion);
-	Record << SA_VALUE(TEXT("TimeStamp"), Timestamp);
+	/** Offset of this level chunk in the archive */
+	uint64 Offset = 0;
 
-	if (bIsLoading)
-	{
-		Archive.SetEngineVer(EngineVersion);
-		Archive.SetUEVer(PackageVersion);
-	}
+	/** When loading, this level chunk's data, which is released once its actors have been applied */
+	TArray<uint8> Data;
 
-	// If we already have a map name, don't change it
-	if (!bIsLoading && LastVisitedMap.IsEmpty())
-	{
-		LastVisitedMap = Subsystem->GetWorld()->GetOutermost()->GetLoadedPath().GetPackageName();
-	}
+	/** Range of this level's actors in ActorData */
+	int32 FirstActorIdx = 0;
+	int32 NumActors = 0;
 
-	Record << SA_VALUE(TEXT("LastVisitedMap"), LastVisitedMap);
-}
+	/** When saving, the pending level that's carried over as it is, as its level isn't resident */
+	TOptional<FSaveGamePendingLevel> Carried;
+};
 
-template <typename FuncType>
-void ExecuteJobs(const int32 NumJobs, TStatId StatId, FuncType&& Job)
+template <bool bIsLoading>
+class TSaveGameSerializer<bIsLoading>::FSnapshotReferencer final : public FGCObject
 {
-	FSaveGameTheadScope GameThreadScope;
-	TAtomic<int32> JobIdx = 0;
-	TAtomic<int32> CompletedJobs = 0;
+public:
+	explicit FSnapshotReferencer(TArray<FActorInfo>& InActorData)
+		: ActorData(InActorData)
+	{
+	}
 
-	const int32 NumThreads = GThreadPool->GetNumThreads();
-	for (int32 ThreadIdx = 0; ThreadIdx < NumThreads; ++ThreadIdx)
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override
 	{
-		GThreadPool->AddQueuedWork(new TAsyncQueuedWork<void>([&]
+		// Snapshots are only taken or released while garbage collection can't run (see FGCScopeGuard)
+		for (FActorInfo& ActorInfo : ActorData)
 		{
-			FScopeCycleCounter Counter(StatId);
-
-			int32 OurJobIdx;
-			while ((OurJobIdx = JobIdx.IncrementExchange()) < NumJobs)
+			if (ActorInfo.Snapshot)
 			{
-				Job(OurJobIdx);
-				++CompletedJobs;
+				ActorInfo.Snapshot->AddReferencedObjects(Collector);
 			}
-		}, TPromise<void>()), EQueuedWorkPriority::Highest);
+		}
 	}
 
-	if (!bForceSingleThreaded)
+	virtual FString GetReferencerName() const override
 	{
-		QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_PumpGameThread);
-
-		// Pump the Work Queue on the game thread
-		while (GameThreadScope.ProcessThread(10000) || CompletedJobs.Load() < NumJobs);
+		return TEXT("FSaveGameSerializer::FSnapshotReferencer");
 	}
 
-	check(CompletedJobs.Load() >= NumJobs);
-}
+private:
+	TArray<FActorInfo>& ActorData;
+};
 
 template <bool bIsLoading>
-void TSaveGameSerializer<bIsLoading>::SerializeActors()
+class TSaveGameSerializer<bIsLoading>::FPackageReferencer final : public FGCObject
 {
-	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SerializeActors);
-
-	// We start in the game thread, as we want to ensure we have control over what accesses UObjects
-	check(IsInGameThread());
+public:
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+	{
+		Collector.AddReferencedObjects(Packages);
+	}
 
-	// This serializes method assumes that we don't have any streamed/sublevels
-	const UWorld* World = Subsystem->GetWorld();
-	LevelAssetPath = FTopLevelAssetPath(World->GetCurrentLevel()->GetPackage()->GetFName(),
-	                                    World->GetCurrentLevel()->GetOuter()->GetFName());
+	virtual FString GetReferencerName() const override
+	{
+		return TEXT("FSaveGameSerializer::FPackageReferencer");
+	}
 
-	SaveGameActors = Subsystem->SaveGameActors.Array();
-	int32 NumActors = SaveGameActors.Num();
+	/** Added to on the game thread, as packages are found or finish loading */
+	TArray<TObjectPtr<UPackage>> Packages;
+	TArray<int32> Requests;
+};
 
-	if (bIsLoading)
+/** What MergeSaveData carries from one level to the next, as each level is merged by its own task */
+template <bool bIsLoading>
+struct TSaveGameSerializer<bIsLoading>::FMergeState
+{
+	TOptional<FStructuredArchive::FStream> LevelStream;
+
+	/** The cache is rebuilt every save, so that it only holds actors that still exist */
+	TMap<TWeakObjectPtr<AActor>, FSaveGameActorCache> ActorCache;
+};
+
+static FTopLevelAssetPath GetLevelAssetPath(const ULevel* Level)
+{
+	return FTopLevelAssetPath(Level->GetPackage()->GetFName(), Level->GetOuter()->GetFName());
+}
+
+/**
+ * Whether data was written with the versions that this build writes, in which case it can be carried into a save as it
+ * is. Custom versions are either ours, the engine's, or the project's (see USaveGameSettings::Versions).
+ */
+static bool IsLatestVersions(const FPackageFileVersion& PackageVersion, const FCustomVersionContainer& Versions)
+{
+	if (PackageVersion != GPackageFileUEVersion)
 	{
-		QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_CollectSpawnIDs);
+		return false;
+	}
 
-		// Iterate through our live actors so that we can map their SpawnIDs
-		for (const TWeakObjectPtr<AActor>& ActorPtr : SaveGameActors)
+	for (const FCustomVersion& Version : Versions.GetAllVersions())
+	{
+		int32 LatestVersion;
+
+		if (Version.Key == FSaveGameVersion::GUID)
 		{
-			AActor* Actor = ActorPtr.Get();
-			if (IsValid(Actor) && Actor->Implements<USaveGameSpawnActor>())
+			LatestVersion = FSaveGameVersion::LatestVersion;
+		}
+		else if (const TOptional<FCustomVersion> CurrentVersion = FCurrentCustomVersions::Get(Version.Key))
+		{
+			LatestVersion = CurrentVersion->Version;
+		}
+		else
+		{
+			LatestVersion = GetDefault<USaveGameSettings>()->GetLatestVersion(Version.Key);
+		}
+
+		if (Version.Version != LatestVersion)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/** The type of a column group's column, which must match its property's for the column to be read */
+static FName GetColumnType(const FProperty* Property)
+{
+	FString ExtendedType;
+	const FString Type = Property->GetCPPType(&ExtendedType);
+	return FName(Type + ExtendedType);
+}
+
+/**
+ * Hashes the SaveGame properties (and transform, if movable) of an actor, used to detect whether an actor has changed
+ * since its data was cached. Returns an unset hash if a SaveGame property can't be hashed, as the actor can't be
+ * cached then.
+ */
+static TOptional<uint32> HashSaveGameState(const AActor* Actor)
+{
+	uint32 Hash = GetTypeHash(Actor->GetClass()->GetFName());
+
+	for (TFieldIterator<FProperty> It(Actor->GetClass()); It; ++It)
+	{
+		const FProperty* Property = *It;
+
+		if (!Property->HasAnyPropertyFlags(CPF_SaveGame))
+		{
+			continue;
+		}
+
+		if (!Property->HasAllPropertyFlags(CPF_HasGetValueTypeHash))
+		{
+			return {};
+		}
+
+		for (int32 ArrayIdx = 0; ArrayIdx < Property->ArrayDim; ++ArrayIdx)
+		{
+			Hash = HashCombineFast(Hash, Property->GetValueTypeHash(Property->ContainerPtrToValuePtr<void>(Actor, ArrayIdx)));
+		}
+	}
+
+	// Transforms are commonly serialized in OnSerialize (see USaveGameFunctionLibrary::SerializeActorTransform)
+	if (Actor->IsRootComponentMovable())
+	{
+		// Hashed by component, as FTransform's vector registers have padding that isn't necessarily initialized
+		const FTransform Transform = Actor->GetActorTransform();
+		const FVector Translation = Transform.GetTranslation();
+		const FQuat Rotation = Transform.GetRotation();
+		const FVector Scale = Transform.GetScale3D();
+
+		const double Components[] = {
+			Translation.X, Translation.Y, Translation.Z,
+			Rotation.X, Rotation.Y, Rotation.Z, Rotation.W,
+			Scale.X, Scale.Y, Scale.Z
+		};
+		Hash = FCrc::MemCrc32(Components, sizeof(Components), Hash);
+	}
+
+	return Hash;
+}
+
+template <bool bIsLoading>
+TSaveGameSerializer<bIsLoading>::TSaveGameSerializer(USaveGameSubsystem* InSubsystem, FString SaveName,
+                                                     ULevel* InLevelToSnapshot)
+	: Subsystem(InSubsystem)
+	  , bJsonOutput(!bIsLoading && !InLevelToSnapshot && ShouldWriteJsonOutput())
+	  , Archive(Data)
+	  , SaveNameTable(bIsLoading ? nullptr : TSharedPtr<FSaveGameNameTable>(InSubsystem->SaveNameTable))
+	  , SaveArchive(new TSaveGameArchive<bIsLoading>(Archive, Redirects, GetNameTable(), bJsonOutput))
+	  , LevelToSnapshot(InLevelToSnapshot)
+	  , SaveName(MoveTemp(SaveName))
+{
+	check(!bIsLoading || !InLevelToSnapshot);
+
+	// Ensure that we're using the latest save game version
+	Archive.UsingCustomVersion(FSaveGameVersion::GUID);
+
+	// Our OnSerialize handlers look up their versions in parallel, so they have to have been published
+	GetDefault<USaveGameSettings>()->PublishVersions();
+
+	if (!bIsLoading)
+	{
+		// We're on the game thread, where the world's time can be read
+		Summary.Emplace().PlayTime = Subsystem->GetPlayTime();
+	}
+}
+
+template <bool bIsLoading>
+TSaveGameSerializer<bIsLoading>::~TSaveGameSerializer()
+{
+	delete SaveArchive;
+}
+
+template <bool bIsLoading>
+FTask TSaveGameSerializer<bIsLoading>::DoOperation()
+{
+	checkf(!LevelToSnapshot, TEXT("Levels are serialized on their own by SnapshotLevel"));
+
+	if (bLoadingPendingLevel)
+	{
+		// Our level's chunk is all there is to read, it was read along with the rest of the save
+		return LaunchGameThread(UE_SOURCE_LOCATION, [this]
+		{
+			SerializeLevels();
+			SerializeActors(0, ActorData.Num());
+		});
+	}
+
+	if (ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem())
+	{
+		FTask PreviousTask;
+
+		if (!bIsLoading)
+		{
+			PreviousTask = Launch(UE_SOURCE_LOCATION, [this] { OpenContainerWriter(); }, PreviousTask);
+		}
+
+		if (bIsLoading)
+		{
+			PreviousTask = Launch(UE_SOURCE_LOCATION, [this, SaveSystem]
 			{
-				const FGuid SpawnID = ISaveGameSpawnActor::Execute_GetSpawnID(Actor);
+				const FString FilePath = FSaveGameContainer::GetFilePath(GetSaveName());
+				bool bOpened;
 
-				if (SpawnID.IsValid())
+				if (FSaveGameContainer::UsesGenericSaveGameSystem() && FPaths::FileExists(FilePath))
 				{
-					SpawnIDs.Add(SpawnID, Actor);
+					// Stream the container, so that only the blocks being decompressed are in memory
+					bOpened = ContainerReader.Open(FilePath);
+				}
+				else
+				{
+					TArray<uint8> ContainerData;
+					if (!SaveSystem->LoadGame(false, *GetSaveName(), 0, ContainerData))
+					{
+						FailLoad(TEXT("the slot doesn't exist"));
+						return;
+					}
+
+					bOpened = ContainerReader.Open(MoveTemp(ContainerData));
+				}
+
+				// The container has logged why it couldn't be opened
+				if (!bOpened)
+				{
+					FailLoad(TEXT("it isn't a save game container that can be read"));
+					return;
+				}
+
+				Toc = ContainerReader.GetTableOfContents();
+				Summary = ContainerReader.GetSummary();
+
+				// Only the header and versions are needed to start travelling, the levels are read meanwhile
+				TArray<uint8> VersionsData;
+				if (!ContainerReader.ReadSection(Toc.Header, Data)
+					|| !ContainerReader.ReadSection(Toc.Versions, VersionsData))
+				{
+					FailLoad(TEXT("its header couldn't be read"));
+					return;
+				}
+
+				// Our data only holds the header and versions, so point their sections at it
+				Data.Append(VersionsData);
+				Toc.Header.Offset = 0;
+				Toc.Versions.Offset = Toc.Header.Size;
+
+				// Older saves don't have a name table, their names and paths are stored as strings
+				if (Toc.Names.Size > 0)
+				{
+					TArray<uint8> NamesData;
+					if (!ContainerReader.ReadSection(Toc.Names, NamesData))
+					{
+						FailLoad(TEXT("its name table couldn't be read"));
+						return;
+					}
+
+					FMemoryReader NamesReader(NamesData);
+					LoadNameTable = MakeShared<FSaveGameNameTable>();
+					LoadNameTable->Serialize(NamesReader, ContainerReader.GetVersion());
+
+					if (NamesReader.IsError())
+					{
+						FailLoad(TEXT("its name table is corrupt"));
+					}
+				}
+			}, PreviousTask);
+		}
+
+		PreviousTask = Launch(UE_SOURCE_LOCATION, [this]
+		{
+			if (!bLoadFailed)
+			{
+				SerializeHeader();
+			}
+		}, PreviousTask);
+
+		if (bIsLoading)
+		{
+			PreviousTask = Launch(UE_SOURCE_LOCATION, [this]
+			{
+				if (bLoadFailed)
+				{
+					return;
+				}
+
+				SerializeVersions();
+
+				// Anything that would stop the save from being applied has to be found before we travel
+				if (Archive.IsError())
+				{
+					FailLoad(TEXT("its header is corrupt"));
+				}
+				else if (Archive.CustomVer(FSaveGameVersion::GUID) < FSaveGameVersion::TableOfContents)
+				{
+					FailLoad(TEXT("it predates the table of contents"));
+				}
+				else if (LastVisitedMap.IsEmpty())
+				{
+					FailLoad(TEXT("it has no map to travel to"));
+				}
+			}, PreviousTask);
+
+			// Read the level chunks while the map is loading, each into their own buffer
+			FTask ReadLevelsTask = Launch(UE_SOURCE_LOCATION, [this]
+			{
+				if (!bLoadFailed)
+				{
+					Levels.SetNum(Toc.Levels.Num());
+
+					for (int32 LevelIdx = 0; LevelIdx < Levels.Num(); ++LevelIdx)
+					{
+						if (!ContainerReader.ReadSection(Toc.Levels[LevelIdx], Levels[LevelIdx].Data))
+						{
+							FailLoad(FString::Printf(TEXT("level %s couldn't be read"), *Toc.Levels[LevelIdx].Name));
+							break;
+						}
+					}
+				}
+
+				ContainerReader.Close();
+			}, PreviousTask);
+
+			FTaskEvent MapLoadEvent(TEXT("MapLoaded"));
+			LaunchGameThread(UE_SOURCE_LOCATION, [this, MapLoadEvent]() mutable
+			{
+				// We stay where we are if the save can't be applied
+				if (bLoadFailed)
+				{
+					MapLoadEvent.Trigger();
+					return;
 				}
+
+				UWorld* World = Subsystem->GetWorld();
+				check(!World->IsInSeamlessTravel());
+
+				// When our map has loaded, continue the serialization process
+				FCoreUObjectDelegates::PostLoadMapWithWorld.AddSPLambda(this, [this, MapLoadEvent](UWorld*) mutable
+				{
+					MapLoadEvent.Trigger();
+
+					const signed int RemovedCount = FCoreUObjectDelegates::PostLoadMapWithWorld.RemoveAll(this);
+					check(RemovedCount == 1);
+				});
+
+				// What the save needs is loaded alongside the map, rather than once our actors are being spawned
+				LoadReferencedPackages();
+
+				World->SeamlessTravel(LastVisitedMap, true);
+			}, PreviousTask);
+
+			// Our next task should wait for the map to be loaded, and the level chunks to be read
+			PreviousTask = Launch(UE_SOURCE_LOCATION, []
+			{
+			}, Prerequisites(MapLoadEvent, ReadLevelsTask), ETaskPriority::Default, EExtendedTaskPriority::Inline);
+		}
+
+		FTaskEvent LevelsGatheredEvent(TEXT("LevelsGathered"));
+		FTaskEvent ActorsSerializedEvent(TEXT("ActorsSerialized"));
+
+		PreviousTask = LaunchGameThread(UE_SOURCE_LOCATION, [this, LevelsGatheredEvent, ActorsSerializedEvent]() mutable
+		{
+			// Levels may fail to be read while we're travelling, in which case none of the save is applied
+			if (bLoadFailed)
+			{
+				LevelsGatheredEvent.Trigger();
+				ActorsSerializedEvent.Trigger();
+				return;
+			}
+
+			const double StartTime = FPlatformTime::Seconds();
+
+			// Play time carries on from where the save left off, now that we're in its world
+			if (bIsLoading && Summary.IsSet())
+			{
+				Subsystem->SetPlayTime(Summary->PlayTime);
+			}
+
+			SerializeLevels();
+			LevelsGatheredEvent.Trigger();
+
+			if (!bIsLoading)
+			{
+				SnapshotReferencer = MakeUnique<FSnapshotReferencer>(ActorData);
+			}
+
+			const double TimeSliceBudget = bIsLoading
+				                               ? 0.0
+				                               : GetDefault<USaveGameSettings>()->GetTimeSliceBudget(GetSaveName());
+
+			if (TimeSliceBudget > 0.0)
+			{
+				SerializeActorsTimeSliced(TimeSliceBudget, ActorsSerializedEvent);
+			}
+			else
+			{
+				ActorsSerializedEvent.AddPrerequisites(SerializeActors(0, ActorData.Num()));
+				ActorsSerializedEvent.Trigger();
+			}
+
+			AddGameThreadTime(FPlatformTime::Seconds() - StartTime);
+		}, PreviousTask);
+
+		// Actors are still being serialized after the game thread task has finished, on workers and when time sliced
+		PreviousTask = Launch(UE_SOURCE_LOCATION, []
+		{
+		}, Prerequisites(PreviousTask, ActorsSerializedEvent), ETaskPriority::Default, EExtendedTaskPriority::Inline);
+
+		if (!bIsLoading)
+		{
+			// Merge (and compress) actors while they're being serialized, rather than once they're all done
+			FTask MergeTask = Launch(UE_SOURCE_LOCATION, [this] { MergeSaveData(); }, LevelsGatheredEvent);
+
+			// Levels are merged by tasks nested in the merge, which have all completed once it has
+			MergeTask = Launch(UE_SOURCE_LOCATION, [this]
+			{
+				SerializeVersions();
+				SerializeNameTable();
+			}, MergeTask);
+
+			PreviousTask = Launch(UE_SOURCE_LOCATION, [this]
+			{
+				// Garbage collection may be looking through our snapshots otherwise
+				FGCScopeGuard GCGuard;
+				SnapshotReferencer.Reset();
+				ActorData.Empty();
+				Arena.BulkDelete();
+			}, Prerequisites(PreviousTask, MergeTask));
+		}
+
+		PreviousTask = Launch(UE_SOURCE_LOCATION, [this]
+		{
+			SaveArchive->Close();
+		}, PreviousTask);
+
+		if (!bIsLoading)
+		{
+#if USE_TEXT_FORMATTER
+			if (bJsonOutput)
+			{
+				PreviousTask = Launch(UE_SOURCE_LOCATION, [this, SaveSystem]
+				{
+					// The JSON has already been written as we went, it only has to be written out. That isn't waited
+					// on, as it's for debugging, so it's handed to a pipe that outlives us and keeps writes in order
+					Subsystem->JsonOutputPipe.Launch(UE_SOURCE_LOCATION,
+						[SaveSystem, JsonName = GetSaveName() + TEXT(".json"),
+							Json = SaveArchive->GetJsonFormatter()->ReleaseText()]
+						{
+							QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_WriteJson);
+							SaveSystem->SaveGame(false, *JsonName, 0, Json);
+						});
+				}, PreviousTask, ETaskPriority::Default, EExtendedTaskPriority::Inline);
 			}
+#endif
+
+			PreviousTask = Launch(UE_SOURCE_LOCATION, [this, SaveSystem]
+			{
+				// Finish the container, along with where each section is
+				StreamSaveData(true);
+				ContainerWriter->Finalize(Toc);
+				ContainerWriter.Reset();
+
+				if (FileWriter.IsValid())
+				{
+					// The rest is written out behind us, our part of the save is done
+					WriteTask = FileWriter->Commit();
+					return;
+				}
+
+				ContainerArchive.Reset();
+				const bool bSaved = SaveSystem->SaveGame(false, *GetSaveName(), 0, ContainerData);
+
+				// Like a save that's written behind us, a failure is reported by OnSaveWritten, not asserted
+				if (!bSaved)
+				{
+					UE_LOG(LogSaveGameSerializer, Error, TEXT("%s: Couldn't write the save"), *GetSaveName());
+				}
+
+				WriteTask = MakeCompletedTask<bool>(bSaved);
+			}, PreviousTask);
 		}
+
+		return PreviousTask;
+	}
+
+	if (bIsLoading)
+	{
+		FailLoad(TEXT("there's no save game system"));
+	}
+
+	WriteTask = MakeCompletedTask<bool>(false);
+	return MakeCompletedTask<void>();
+}
+
+template <bool bIsLoading>
+void TSaveGameSerializer<bIsLoading>::SerializeHeader()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SerializeHeader);
+
+	FEngineVersion EngineVersion;
+	FPackageFileVersion PackageVersion;
+	FDateTime Timestamp;
+
+	if (!bIsLoading)
+	{
+		// The container's summary has these too, so that they can be read without decompressing the header
+		EngineVersion = Summary->EngineVersion;
+		PackageVersion = GPackageFileUEVersion;
+		Timestamp = Summary->Timestamp;
 	}
+	else
+	{
+		Archive.Seek(Toc.Header.Offset);
+	}
+
+	Toc.Header.Offset = GetArchiveOffset();
+
+	FStructuredArchive::FRecord& Record = SaveArchive->GetRecord();
+
+	Record << SA_VALUE(TEXT("EngineVersion"), EngineVersion);
+	Record << SA_VALUE(TEXT("PackageVersion"), PackageVersion);
+	Record << SA_VALUE(TEXT("TimeStamp"), Timestamp);
+
+	if (bIsLoading)
+	{
+		Archive.SetEngineVer(EngineVersion);
+		Archive.SetUEVer(PackageVersion);
+	}
+
+	Record << SA_VALUE(TEXT("LastVisitedMap"), LastVisitedMap);
+
+	Toc.Header.Size = GetArchiveOffset() - Toc.Header.Offset;
+}
+
+/**
+ * Launches the jobs on up to USaveGameSettings::MaxWorkers task workers, returning a task that completes once they're
+ * all done. Workers take batches of jobs from a shared counter, the batches shrink as the jobs run out so that a
+ * worker stuck on an expensive batch doesn't hold up the rest.
+ */
+template <typename FuncType>
+FTask LaunchJobs(const int32 NumJobs, TStatId StatId, FuncType&& Job)
+{
+	if (bForceSingleThreaded)
+	{
+		for (int32 JobIdx = 0; JobIdx < NumJobs; ++JobIdx)
+		{
+			Job(JobIdx);
+		}
+
+		return FTask();
+	}
+
+	// Larger batches amortize the cost of taking them, but leave less to balance between workers
+	constexpr int32 MaxBatchSize = 64;
+	constexpr int32 BatchesPerWorker = 4;
+
+	// Shared between the workers, as they can outlive the caller
+	struct FJobs
+	{
+		explicit FJobs(FuncType&& InJob)
+			: Job(Forward<FuncType>(InJob))
+		{
+		}
+
+		std::decay_t<FuncType> Job;
+		std::atomic<int32> NextJobIdx = 0;
+	};
+
+	const TSharedRef<FJobs> Jobs = MakeShared<FJobs>(Forward<FuncType>(Job));
+	const int32 NumWorkers = FMath::Clamp(GetDefault<USaveGameSettings>()->GetNumWorkers(), 1, FMath::Max(NumJobs, 1));
+
+	TArray<FTask> WorkerTasks;
+	WorkerTasks.Reserve(NumWorkers);
+
+	for (int32 WorkerIdx = 0; WorkerIdx < NumWorkers; ++WorkerIdx)
+	{
+		WorkerTasks.Add(Launch(UE_SOURCE_LOCATION, [Jobs, NumJobs, NumWorkers, StatId]
+		{
+			FScopeCycleCounter Counter(StatId);
+
+			while (true)
+			{
+				const int32 RemainingJobs = NumJobs - Jobs->NextJobIdx.load(std::memory_order_relaxed);
+				const int32 BatchSize = FMath::Clamp(RemainingJobs / (NumWorkers * BatchesPerWorker), 1, MaxBatchSize);
+				const int32 FirstJobIdx = Jobs->NextJobIdx.fetch_add(BatchSize);
+
+				if (FirstJobIdx >= NumJobs)
+				{
+					break;
+				}
+
+				const int32 LastJobIdx = FMath::Min(FirstJobIdx + BatchSize, NumJobs);
+				for (int32 JobIdx = FirstJobIdx; JobIdx < LastJobIdx; ++JobIdx)
+				{
+					Jobs->Job(JobIdx);
+				}
+			}
+		}));
+	}
+
+	return Launch(UE_SOURCE_LOCATION, []
+	{
+	}, Prerequisites(WorkerTasks), ETaskPriority::Default, EExtendedTaskPriority::Inline);
+}
+
+/**
+ * Runs the jobs (see LaunchJobs), while the calling (game) thread services ISaveGameThreadQueue until they're done.
+ */
+template <typename FuncType>
+void ExecuteJobs(const int32 NumJobs, TStatId StatId, FuncType&& Job)
+{
+	FSaveGameTheadScope GameThreadScope;
+	const FTask JobsTask = LaunchJobs(NumJobs, StatId, Forward<FuncType>(Job));
+
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_PumpGameThread);
+
+	// Service the game thread work that our jobs queue up, until they've all completed
+	GameThreadScope.ProcessUntil(JobsTask);
+}
+
+template <bool bIsLoading>
+void TSaveGameSerializer<bIsLoading>::SerializeLevels()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SerializeLevels);
+
+	// We start in the game thread, as we want to ensure we have control over what accesses UObjects
+	check(IsInGameThread());
+
+	const UWorld* World = Subsystem->GetWorld();
+
+	// Only levels that are resident will have their actors serialized
+	TMap<FTopLevelAssetPath, ULevel*> ResidentLevels;
+	for (ULevel* Level : World->GetLevels())
+	{
+		if (IsValid(Level))
+		{
+			ResidentLevels.Add(GetLevelAssetPath(Level), Level);
+		}
+	}
+
+	if (bIsLoading)
+	{
+		// Loads check this before they travel, but a pending level's context comes from the save that left it
+		if (Archive.CustomVer(FSaveGameVersion::GUID) < FSaveGameVersion::TableOfContents)
+		{
+			FailLoad(TEXT("it predates the table of contents"));
+			return;
+		}
+
+		// Loading a pending level only changes the actors of that level
+		if (!bLoadingPendingLevel)
+		{
+			// Destroyed actors will be re-added as each level chunk is read
+			Subsystem->DestroyedLevelActors.Reset();
+
+			// Our actors are about to change wholesale, any cached data (and the last load's levels) are stale, along
+			// with the name table that they referenced
+			Subsystem->ActorCache.Reset();
+			Subsystem->DirtyActors.Reset();
+			Subsystem->PendingLevels.Reset();
+			Subsystem->SaveNameTable = MakeShared<FSaveGameNameTable>();
+		}
+
+		for (int32 LevelIdx = 0; LevelIdx < Levels.Num(); ++LevelIdx)
+		{
+			FLevelInfo& LevelInfo = Levels[LevelIdx];
+			LevelInfo.ActorOffsets = Toc.Levels[LevelIdx].ActorOffsets;
+
+			// Each level chunk has its own data, so read its header with its own archive
+			{
+				TSaveGameMemoryArchive LevelMemoryArchive(LevelInfo.Data);
+				TSaveGameArchive<bIsLoading> LevelArchive(LevelMemoryArchive, Redirects, GetNameTable());
+				LevelArchive.ConsolidateVersions(*SaveArchive);
+
+				SerializeLevelHeader(LevelArchive.GetRecord(), LevelInfo);
+				LevelArchive.Close();
+			}
+
+			if (ULevel** Level = ResidentLevels.Find(LevelInfo.LevelAssetPath))
+			{
+				LevelInfo.Level = *Level;
+			}
+
+			ApplyDestroyedActors(LevelInfo);
+
+			// Actors in levels that aren't resident are skipped entirely
+			if (LevelInfo.Level.IsValid())
+			{
+				LevelInfo.FirstActorIdx = ActorData.Num();
+				LevelInfo.NumActors = LevelInfo.ActorOffsets.Num();
+
+				for (const uint32 ActorOffset : LevelInfo.ActorOffsets)
+				{
+					FActorInfo& ActorInfo = ActorData.AddDefaulted_GetRef();
+					ActorInfo.LevelIdx = LevelIdx;
+					ActorInfo.Offset = ActorOffset;
+				}
+
+				for (FColumnGroup& Group : LevelInfo.ColumnGroups)
+				{
+					Group.ActorIndices.Reset(Group.Rows.Num());
+
+					for (const int32 Row : Group.Rows)
+					{
+						const bool bValidRow = Row >= 0 && Row < LevelInfo.NumActors;
+						Group.ActorIndices.Add(bValidRow ? LevelInfo.FirstActorIdx + Row : INDEX_NONE);
+					}
+				}
+			}
+			else
+			{
+				if (!bLoadingPendingLevel && !LevelInfo.ActorOffsets.IsEmpty())
+				{
+					// Kept as it is until the level is streamed in (see USaveGameSubsystem::OnLevelAddedToWorld)
+					FSaveGamePendingLevel& PendingLevel = Subsystem->PendingLevels.Add(LevelInfo.LevelAssetPath);
+					PendingLevel.Data = MakeSharedBufferFromArray(MoveTemp(LevelInfo.Data));
+					PendingLevel.ActorOffsets = MoveTemp(LevelInfo.ActorOffsets);
+					PendingLevel.Context = GetLoadContext();
+				}
+
+				// Nothing else will read this level's actors
+				LevelInfo.Data.Empty();
+				LevelInfo.ColumnGroups.Empty();
+			}
+		}
+
+		// Our pending levels reference our name table, so saves carry on with it to be able to carry them over
+		if (!bLoadingPendingLevel && LoadNameTable && !Subsystem->PendingLevels.IsEmpty())
+		{
+			Subsystem->SaveNameTable = LoadNameTable.ToSharedRef();
+		}
+	}
+	else if (LevelToSnapshot)
+	{
+		// Only the level being streamed out, from scratch, as what carries over from save to save is left to the saves
+		ResidentLevels.Reset();
+		ResidentLevels.Add(GetLevelAssetPath(LevelToSnapshot), LevelToSnapshot);
+	}
+	else
+	{
+		bIncrementalSave = GetDefault<USaveGameSettings>()->bIncrementalSaves;
+
+		// Cached data references the name table of the save it was cached by, so they're only carried over together.
+		// Pending levels are also carried over with the name table that they reference
+		FSaveGameNameTable* NameTable = GetNameTable();
+		const bool bPendingLevelsUseNameTable = Algo::AnyOf(Subsystem->PendingLevels,
+			[NameTable](const TPair<FTopLevelAssetPath, FSaveGamePendingLevel>& PendingLevel)
+			{
+				return PendingLevel.Value.Context->NameTable.Get() == NameTable;
+			});
+
+		if (!bIncrementalSave || Subsystem->ActorCache.IsEmpty())
+		{
+			Subsystem->ActorCache.Reset();
+
+			if (!bPendingLevelsUseNameTable)
+			{
+				NameTable->Reset();
+			}
+		}
+
+		// Object paths are only cached for the length of a save, so that destroyed objects aren't kept in the table
+		NameTable->ResetObjects();
+
+		// Our actor cache only replaces the subsystem's if it's still this world once we're done
+		SavedWorld = Subsystem->GetWorld();
+
+		// Take ownership of the actors that changed since the last save, new changes will be tracked for the next
+		DirtyActors = MoveTemp(Subsystem->DirtyActors);
+		Subsystem->DirtyActors.Reset();
+	}
+
+	if (!bIsLoading)
+	{
+		TMap<FTopLevelAssetPath, int32> LevelIndices;
+		auto FindOrAddLevel = [this, &LevelIndices](const FTopLevelAssetPath& LevelAssetPath, ULevel* Level)
+		{
+			if (const int32* LevelIdx = LevelIndices.Find(LevelAssetPath))
+			{
+				return *LevelIdx;
+			}
+
+			const int32 LevelIdx = Levels.AddDefaulted();
+			Levels[LevelIdx].Level = Level;
+			Levels[LevelIdx].LevelAssetPath = LevelAssetPath;
+			LevelIndices.Add(LevelAssetPath, LevelIdx);
+			return LevelIdx;
+		};
+
+		for (const TPair<FTopLevelAssetPath, ULevel*>& ResidentLevel : ResidentLevels)
+		{
+			FindOrAddLevel(ResidentLevel.Key, ResidentLevel.Value);
+		}
+
+		// Pending levels are carried over as they are, if their chunks can be read as part of our save
+		if (!LevelToSnapshot)
+		{
+			for (const TPair<FTopLevelAssetPath, FSaveGamePendingLevel>& PendingLevel : Subsystem->PendingLevels)
+			{
+				const FSaveGameLoadContext& Context = *PendingLevel.Value.Context;
+
+				if (Context.bLatestVersions && Context.NameTable.Get() == GetNameTable())
+				{
+					Levels[FindOrAddLevel(PendingLevel.Key, nullptr)].Carried = PendingLevel.Value;
+				}
+				else
+				{
+					UE_LOG(LogSaveGameSerializer, Warning,
+					       TEXT("%s: Leaving out the saved actors of %s (which isn't loaded), as an older version saved them"),
+					       *GetSaveName(), *PendingLevel.Key.ToString());
+				}
+			}
+		}
+
+		// Destroyed actors are kept even if their level isn't resident, so that they stay destroyed
+		for (const FSoftObjectPath& DestroyedActor : Subsystem->DestroyedLevelActors)
+		{
+			const FTopLevelAssetPath LevelAssetPath = DestroyedActor.GetAssetPath();
+
+			if (LevelToSnapshot && !ResidentLevels.Contains(LevelAssetPath))
+			{
+				continue;
+			}
+
+			const int32 LevelIdx = FindOrAddLevel(LevelAssetPath, nullptr);
+
+			// A carried level has its destroyed actors in its chunk already
+			if (Levels[LevelIdx].Carried.IsSet())
+			{
+				continue;
+			}
+
+			// Only store the object name without the prefix and full path
+			FString ActorSubPath = DestroyedActor.GetSubPathString();
+			ActorSubPath.RemoveFromStart(LEVEL_SUBPATH_PREFIX);
+			Levels[LevelIdx].DestroyedActors.Add(*ActorSubPath);
+		}
+
+		// Group our actors by level, so that each level's actors are contiguous in ActorData
+		TArray<TArray<AActor*>> LevelActors;
+		LevelActors.SetNum(Levels.Num());
+
+		for (const TWeakObjectPtr<AActor>& ActorPtr : Subsystem->SaveGameActors)
+		{
+			AActor* Actor = ActorPtr.Get();
+			if (!IsValid(Actor) || !IsValid(Actor->GetLevel())
+				|| (LevelToSnapshot && Actor->GetLevel() != LevelToSnapshot))
+			{
+				continue;
+			}
+
+			const int32 LevelIdx = FindOrAddLevel(GetLevelAssetPath(Actor->GetLevel()), Actor->GetLevel());
+			LevelActors.SetNum(Levels.Num());
+
+			// A carried level's actors are in its chunk, even if it's resident but hasn't been added to the world yet
+			if (!Levels[LevelIdx].Carried.IsSet())
+			{
+				LevelActors[LevelIdx].Add(Actor);
+			}
+		}
+
+		const int32 ColumnGroupThreshold = GetDefault<USaveGameSettings>()->ColumnGroupThreshold;
+
+		for (int32 LevelIdx = 0; LevelIdx < Levels.Num(); ++LevelIdx)
+		{
+			FLevelInfo& LevelInfo = Levels[LevelIdx];
+			LevelInfo.FirstActorIdx = ActorData.Num();
+			LevelInfo.NumActors = LevelActors[LevelIdx].Num();
+
+			// Classes with enough actors in this level have them stored in a column group
+			TMap<const UClass*, int32> ClassCounts;
+			if (ColumnGroupThreshold > 0)
+			{
+				for (const AActor* Actor : LevelActors[LevelIdx])
+				{
+					++ClassCounts.FindOrAdd(Actor->GetClass());
+				}
+			}
+
+			for (AActor* Actor : LevelActors[LevelIdx])
+			{
+				FActorInfo& ActorInfo = ActorData.AddDefaulted_GetRef();
+				ActorInfo.Actor = Actor;
+				ActorInfo.Name = Actor->GetName();
+				ActorInfo.LevelIdx = LevelIdx;
+				ActorInfo.bLevelActor = USaveGameFunctionLibrary::WasObjectLoaded(Actor);
+				ActorInfo.bColumnar = ColumnGroupThreshold > 0 && ClassCounts[Actor->GetClass()] >= ColumnGroupThreshold;
+			}
+		}
+	}
+}
+
+template <bool bIsLoading>
+void TSaveGameSerializer<bIsLoading>::SerializeLevelHeader(FStructuredArchive::FRecord& Record, FLevelInfo& LevelInfo)
+{
+	FString LevelName;
+
+	if (!bIsLoading)
+	{
+		LevelName = LevelInfo.LevelAssetPath.ToString();
+	}
+
+	Record << SA_VALUE(TEXT("Name"), LevelName);
+
+	if (bIsLoading)
+	{
+		LevelInfo.LevelAssetPath.TrySetPath(LevelName);
+	}
+
+	int32 NumDestroyedActors = LevelInfo.DestroyedActors.Num();
+	FStructuredArchive::FArray DestroyedActorsArray = Record.EnterArray(TEXT("DestroyedActors"), NumDestroyedActors);
+
+	if (bIsLoading)
+	{
+		LevelInfo.DestroyedActors.SetNum(NumDestroyedActors);
+	}
+
+	for (FName& ActorName : LevelInfo.DestroyedActors)
+	{
+		DestroyedActorsArray.EnterElement() << ActorName;
+	}
+
+	if (bIsLoading && Archive.CustomVer(FSaveGameVersion::GUID) < FSaveGameVersion::ColumnGroups)
+	{
+		return;
+	}
+
+	int32 NumColumnGroups = LevelInfo.ColumnGroups.Num();
+	FStructuredArchive::FArray ColumnGroupsArray = Record.EnterArray(TEXT("ColumnGroups"), NumColumnGroups);
+
+	if (bIsLoading)
+	{
+		LevelInfo.ColumnGroups.SetNum(NumColumnGroups);
+	}
+
+	for (FColumnGroup& Group : LevelInfo.ColumnGroups)
+	{
+		FStructuredArchive::FRecord GroupRecord = ColumnGroupsArray.EnterElement().EnterRecord();
+		GroupRecord << SA_VALUE(TEXT("Class"), Group.Class);
+		GroupRecord << SA_VALUE(TEXT("Rows"), Group.Rows);
+
+		int32 NumColumns = Group.Columns.Num();
+		FStructuredArchive::FArray ColumnsArray = GroupRecord.EnterArray(TEXT("Columns"), NumColumns);
+
+		if (bIsLoading)
+		{
+			Group.Columns.SetNum(NumColumns);
+		}
+
+		for (typename FColumnGroup::FColumn& Column : Group.Columns)
+		{
+			FStructuredArchive::FRecord ColumnRecord = ColumnsArray.EnterElement().EnterRecord();
+			ColumnRecord << SA_VALUE(TEXT("Name"), Column.Name);
+			ColumnRecord << SA_VALUE(TEXT("Type"), Column.Type);
+
+#if USE_TEXT_FORMATTER
+			FJsonOutputArchiveFormatter* JsonFormatter = SaveArchive->GetJsonFormatter();
+			if (JsonFormatter && !Column.Json.IsEmpty())
+			{
+				// Text formatters would store the column's bytes as a blob, so give them its record's JSON instead
+				JsonFormatter->SpliceNextBlob(Column.Json);
+			}
+#endif
+
+			ColumnRecord << SA_VALUE(TEXT("Values"), Column.Values);
+		}
+	}
+}
+
+template <bool bIsLoading>
+void TSaveGameSerializer<bIsLoading>::SerializeColumnGroup(FColumnGroup& Group)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SerializeColumnGroup);
+
+	if (!bIsLoading)
+	{
+		// Garbage collection can't be allowed to release (or null out) what our snapshots reference meanwhile
+		FGCScopeGuard GCGuard;
+
+		const UClass* Class = ActorData[Group.ActorIndices[0]].Snapshot->GetClass();
+
+		for (TFieldIterator<FProperty> It(Class); It; ++It)
+		{
+			const FProperty* Property = *It;
+			if (!Property->HasAnyPropertyFlags(CPF_SaveGame))
+			{
+				continue;
+			}
+
+			typename FColumnGroup::FColumn& Column = Group.Columns.AddDefaulted_GetRef();
+			Column.Name = Property->GetFName();
+			Column.Type = GetColumnType(Property);
+
+			// Like tagged properties, only values that differ from the archetype's are stored
+			TBitArray<> HasValue(false, Group.ActorIndices.Num());
+
+			for (int32 Row = 0; Row < Group.ActorIndices.Num(); ++Row)
+			{
+				const FSaveGamePropertySnapshot& Snapshot = *ActorData[Group.ActorIndices[Row]].Snapshot;
+
+				for (int32 ArrayIdx = 0; ArrayIdx < Property->ArrayDim && !HasValue[Row]; ++ArrayIdx)
+				{
+					HasValue[Row] = !Snapshot.GetArchetype()
+						|| !Property->Identical_InContainer(Snapshot.GetMemory(), Snapshot.GetArchetype(), ArrayIdx);
+				}
+			}
+
+			TSaveGameMemoryArchive ColumnMemoryArchive(Column.Values);
+			TSaveGameArchive<bIsLoading> ColumnArchive(ColumnMemoryArchive, Redirects, GetNameTable(), bJsonOutput);
+
+			FStructuredArchive::FRecord& Record = ColumnArchive.GetRecord();
+
+			const int32 NumWords = static_cast<int32>(FBitSet::CalculateNumWords(HasValue.Num()));
+			TArray<uint32> HasValueWords(HasValue.GetData(), NumWords);
+			Record << SA_VALUE(TEXT("HasValue"), HasValueWords);
+
+			FStructuredArchive::FStream ValueStream = Record.EnterStream(TEXT("Values"));
+
+			for (TConstSetBitIterator<> RowIt(HasValue); RowIt; ++RowIt)
+			{
+				uint8* Memory = ActorData[Group.ActorIndices[RowIt.GetIndex()]].Snapshot->GetMemory();
+
+				for (int32 ArrayIdx = 0; ArrayIdx < Property->ArrayDim; ++ArrayIdx)
+				{
+					Property->SerializeItem(ValueStream.EnterElement(),
+					                        Property->ContainerPtrToValuePtr<void>(Memory, ArrayIdx));
+				}
+			}
+
+			ColumnArchive.Close();
+
+#if USE_TEXT_FORMATTER
+			if (FJsonOutputArchiveFormatter* JsonFormatter = ColumnArchive.GetJsonFormatter())
+			{
+				Column.Json = JsonFormatter->ReleaseText();
+			}
+#endif
+
+			for (const FCustomVersion& Version : ColumnArchive.GetArchive().GetCustomVersions().GetAllVersions())
+			{
+				Group.Versions.SetVersion(Version.Key, Version.Version, Version.GetFriendlyName());
+			}
+		}
+
+		// Our snapshots have been serialized, they're no longer needed
+		for (const int32 ActorIdx : Group.ActorIndices)
+		{
+			ActorData[ActorIdx].Snapshot.Reset();
+		}
+
+		return;
+	}
+
+	const UClass* Class = Group.ResolvedClass;
+
+	if (!Class)
+	{
+		UE_LOG(LogSaveGameSerializer, Warning, TEXT("%s: Skipping column group, as %s couldn't be found"),
+		       *GetSaveName(), *Group.Class.ToString());
+		return;
+	}
+
+	for (typename FColumnGroup::FColumn& Column : Group.Columns)
+	{
+		const FProperty* Property = FindFProperty<FProperty>(Class, Column.Name);
+
+		if (!Property)
+		{
+			const FName RedirectedName = FProperty::FindRedirectedPropertyName(Class, Column.Name);
+			Property = RedirectedName.IsNone() ? nullptr : FindFProperty<FProperty>(Class, RedirectedName);
+		}
+
+		if (!Property || GetColumnType(Property) != Column.Type)
+		{
+			UE_LOG(LogSaveGameSerializer, Warning, TEXT("%s: Skipping column %s of %s, as its property has changed"),
+			       *GetSaveName(), *Column.Name.ToString(), *Class->GetName());
+			continue;
+		}
+
+		TSaveGameMemoryArchive ColumnMemoryArchive(Column.Values);
+		TSaveGameArchive<bIsLoading> ColumnArchive(ColumnMemoryArchive, Redirects, GetNameTable());
+		ColumnArchive.ConsolidateVersions(*SaveArchive);
+
+		FStructuredArchive::FRecord& Record = ColumnArchive.GetRecord();
+
+		TBitArray<> HasValue;
+
+		if (Archive.CustomVer(FSaveGameVersion::GUID) < FSaveGameVersion::StructuredColumns)
+		{
+			Record.GetUnderlyingArchive() << HasValue;
+		}
+		else
+		{
+			TArray<uint32> HasValueWords;
+			Record << SA_VALUE(TEXT("HasValue"), HasValueWords);
+
+			if (HasValueWords.Num() == static_cast<int32>(FBitSet::CalculateNumWords(Group.ActorIndices.Num())))
+			{
+				HasValue.Init(false, Group.ActorIndices.Num());
+
+				// Set bit by bit, so that stray bits past the last row are ignored
+				for (int32 Row = 0; Row < HasValue.Num(); ++Row)
+				{
+					HasValue[Row] = (HasValueWords[Row / NumBitsPerDWORD] & (1u << (Row % NumBitsPerDWORD))) != 0;
+				}
+			}
+		}
+
+		if (HasValue.Num() != Group.ActorIndices.Num())
+		{
+			UE_LOG(LogSaveGameSerializer, Error, TEXT("%s: Column %s of %s is corrupt"),
+			       *GetSaveName(), *Column.Name.ToString(), *Class->GetName());
+			ColumnArchive.Close();
+			continue;
+		}
+
+		FStructuredArchive::FStream ValueStream = Record.EnterStream(TEXT("Values"));
+
+		// The values of actors that are gone (or are no longer of this class) still have to be read past
+		void* Scratch = nullptr;
+
+		for (TConstSetBitIterator<> RowIt(HasValue); RowIt; ++RowIt)
+		{
+			const int32 ActorIdx = Group.ActorIndices[RowIt.GetIndex()];
+			AActor* Actor = ActorIdx != INDEX_NONE ? ActorData[ActorIdx].Actor.Get() : nullptr;
+			const bool bApply = IsValid(Actor) && Actor->IsA(Class);
+
+			if (!bApply && !Scratch)
+			{
+				Scratch = FMemory::Malloc(Property->GetElementSize(), Property->GetMinAlignment());
+				Property->InitializeValue(Scratch);
+			}
+
+			for (int32 ArrayIdx = 0; ArrayIdx < Property->ArrayDim; ++ArrayIdx)
+			{
+				Property->SerializeItem(ValueStream.EnterElement(),
+				                        bApply ? Property->ContainerPtrToValuePtr<void>(Actor, ArrayIdx) : Scratch);
+			}
+		}
+
+		if (Scratch)
+		{
+			Property->DestroyValue(Scratch);
+			FMemory::Free(Scratch);
+		}
+
+		ColumnArchive.Close();
+	}
+}
+
+template <bool bIsLoading>
+FTask TSaveGameSerializer<bIsLoading>::SerializeActors(int32 FirstActorIdx, int32 NumActors)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SerializeActors);
+
+	// We start in the game thread, as we want to ensure we have control over what accesses UObjects
+	check(IsInGameThread());
+
+	// Loading applies every actor at once, so that redirects are populated before any actor is serialized
+	check(!bIsLoading || (FirstActorIdx == 0 && NumActors == ActorData.Num()));
+
+	if (bIsLoading)
+	{
+		QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_CollectSpawnIDs);
+
+		// Iterate through our live actors so that we can map their SpawnIDs
+		for (const TWeakObjectPtr<AActor>& ActorPtr : Subsystem->SaveGameActors)
+		{
+			AActor* Actor = ActorPtr.Get();
+			if (IsValid(Actor) && Actor->Implements<USaveGameSpawnActor>())
+			{
+				const FGuid SpawnID = ISaveGameSpawnActor::Execute_GetSpawnID(Actor);
+
+				if (SpawnID.IsValid())
+				{
+					SpawnIDs.Add(SpawnID, Actor);
+				}
+			}
+		}
+	}
+
+	// Our packages were requested before travel, whatever hasn't finished loading yet is waited for in one go
+	if (bIsLoading && PackageReferencer && !PackageReferencer->Requests.IsEmpty())
+	{
+		QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_FlushReferencedPackages);
+		FlushAsyncLoading(PackageReferencer->Requests);
+	}
+
+	// Need to init actors first for the sake of populating redirects before serialization
+	// When saving, this takes the snapshot of each actor, which is all that's left for the game thread to do
+	{
+		QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_InitializeActors);
+
+		ExecuteJobs(NumActors, GET_STATID(STAT_SaveGame_InitializeActors),
+		            [this, FirstActorIdx](int32 JobIdx) { InitializeActor(FirstActorIdx + JobIdx); });
+	}
+
+	if (!bIsLoading)
+	{
+		// Our snapshots are complete, serialize them while the game carries on
+		QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_Serialize);
+
+		return LaunchJobs(NumActors, GET_STATID(STAT_SaveGame_Serialize),
+		                  [this, FirstActorIdx](int32 JobIdx) { SerializeActor(FirstActorIdx + JobIdx); });
+	}
+
+	// Every actor has been spawned (or found), so their redirects can be published before they're looked up
+	Redirects.Freeze();
+
+	// The levels that we left pending (or that are still pending) are loaded with ours, as they can reference our actors
+	if (LoadContext && LoadContext->Redirects)
+	{
+		LoadContext->Redirects->Append(Redirects);
+		LoadContext->Redirects->Freeze();
+	}
+
+	// The save references the same objects many times over, so each path of the name table is only resolved once
+	if (const FSaveGameNameTable* NameTable = GetNameTable())
+	{
+		Redirects.CacheReferences(NameTable->NumPaths());
+	}
+
+	// Column groups hold the SaveGame properties of their actors, which are applied before any OnSerialize
+	{
+		QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SerializeColumnGroups);
+
+		TArray<FColumnGroup*> ColumnGroups;
+		for (FLevelInfo& LevelInfo : Levels)
+		{
+			for (FColumnGroup& Group : LevelInfo.ColumnGroups)
+			{
+				// Resolved here, alongside the actors themselves
+				Group.ResolvedClass = Group.Class.ResolveClass();
+				ColumnGroups.Add(&Group);
+			}
+		}
+
+		ExecuteJobs(ColumnGroups.Num(), GET_STATID(STAT_SaveGame_SerializeColumnGroups),
+		            [this, &ColumnGroups](int32 JobIdx) { SerializeColumnGroup(*ColumnGroups[JobIdx]); });
+	}
+
+	// Actually do the serialization of each actor (now that we've published redirects)
+	{
+		QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_Serialize);
+
+		ExecuteJobs(NumActors, GET_STATID(STAT_SaveGame_Serialize),
+		            [this, FirstActorIdx](int32 JobIdx) { SerializeActor(FirstActorIdx + JobIdx); });
+	}
+
+	for (FActorInfo& ActorInfo : ActorData)
+	{
+		ActorInfo.Archive->Close();
+	}
+
+	// Our actors have been applied, so their level data is no longer needed
+	for (FLevelInfo& LevelInfo : Levels)
+	{
+		LevelInfo.Data.Empty();
+		LevelInfo.ColumnGroups.Empty();
+	}
+
+	// Whatever our actors reference keeps what they need loaded from here on
+	PackageReferencer.Reset();
+
+	return FTask();
+}
+
+template <bool bIsLoading>
+void TSaveGameSerializer<bIsLoading>::LoadReferencedPackages()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_LoadReferencedPackages);
+
+	check(bIsLoading && IsInGameThread());
+
+	// Only saves with a name table know what they need up front
+	const FSaveGameNameTable* NameTable = GetNameTable();
+	if (!NameTable)
+	{
+		return;
+	}
+
+	PackageReferencer = MakeUnique<FPackageReferencer>();
+
+	// Levels are loaded by travel and streaming, never by a reference to them or their actors
+	TSet<FName> Packages;
+	Packages.Add(*LastVisitedMap);
+
+	for (const FSaveGameTableOfContents::FLevelSection& LevelSection : Toc.Levels)
+	{
+		Packages.Add(FTopLevelAssetPath(LevelSection.Name).GetPackageName());
+	}
+
+	for (int32 PathIdx = 0; PathIdx < NameTable->NumPaths(); ++PathIdx)
+	{
+		const FSoftObjectPath& Path = NameTable->GetPath(PathIdx);
+
+		if (!NameTable->IsObjectPath(PathIdx) || Path.IsNull()
+			|| Path.GetSubPathString().StartsWith(LEVEL_SUBPATH_PREFIX))
+		{
+			continue;
+		}
+
+		bool bAlreadyAdded = false;
+		const FName PackageName = Path.GetLongPackageFName();
+		Packages.Add(PackageName, &bAlreadyAdded);
+
+		if (bAlreadyAdded)
+		{
+			continue;
+		}
+
+		// Packages that are already loaded are kept, as travel would otherwise collect the ones only our map uses
+		if (UPackage* Package = FindPackage(nullptr, *PackageName.ToString()))
+		{
+			PackageReferencer->Packages.Add(Package);
+			continue;
+		}
+
+		PackageReferencer->Requests.Add(LoadPackageAsync(PackageName.ToString(),
+			FLoadPackageAsyncDelegate::CreateSPLambda(this,
+				[this](const FName&, UPackage* Package, EAsyncLoadingResult::Type)
+				{
+					if (Package && PackageReferencer)
+					{
+						PackageReferencer->Packages.Add(Package);
+					}
+				})));
+	}
+}
+
+template <bool bIsLoading>
+void TSaveGameSerializer<bIsLoading>::SerializeActorsTimeSliced(double BudgetSeconds, FTaskEvent CompletedEvent)
+{
+	check(!bIsLoading);
+
+	if (ActorData.IsEmpty())
+	{
+		CompletedEvent.Trigger();
+		return;
+	}
+
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSPLambda(this,
+		[this, BudgetSeconds, CompletedEvent, NextActorIdx = 0, SecondsPerActor = 0.0](float) mutable
+		{
+			QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SerializeActorsSlice);
+
+			// Until we know how long an actor takes, start with a small slice
+			constexpr int32 InitialSliceSize = 16;
+
+			const int32 RemainingActors = ActorData.Num() - NextActorIdx;
+			const int32 SliceSize = SecondsPerActor > 0.0
+				                        ? FMath::Clamp(FMath::FloorToInt32(BudgetSeconds / SecondsPerActor), 1, RemainingActors)
+				                        : FMath::Min(InitialSliceSize, RemainingActors);
+
+			const double StartTime = FPlatformTime::Seconds();
+			CompletedEvent.AddPrerequisites(SerializeActors(NextActorIdx, SliceSize));
+			NextActorIdx += SliceSize;
+
+			const double SliceSeconds = FPlatformTime::Seconds() - StartTime;
+			AddGameThreadTime(SliceSeconds);
+
+			// Smooth our estimate, as the cost of actors varies between slices
+			const double SliceSecondsPerActor = SliceSeconds / SliceSize;
+			SecondsPerActor = SecondsPerActor > 0.0
+				                  ? FMath::Lerp(SecondsPerActor, SliceSecondsPerActor, 0.5)
+				                  : SliceSecondsPerActor;
+
+			if (NextActorIdx < ActorData.Num())
+			{
+				return true;
+			}
+
+			CompletedEvent.Trigger();
+			return false;
+		}));
+}
+
+template <bool bIsLoading>
+void TSaveGameSerializer<bIsLoading>::InitializeActor(int32 ActorIdx)
+{
+	const FString EventStr = FString::Printf(TEXT("InitializeActor: %i"), ActorIdx);
+	SCOPED_NAMED_EVENT_FSTRING(EventStr, FColor::Red);
+
+	FActorInfo& ActorInfo = ActorData[ActorIdx];
+
+	if (!bIsLoading)
+	{
+		AActor* Actor = ActorInfo.Actor.Get();
+
+		if (!IsValid(Actor))
+		{
+			// Destroyed since the save started (while time slicing), it will be left out of this save
+			return;
+		}
+
+		// Actors in column groups aren't cached, their properties are serialized along with the rest of their group
+		if (bIncrementalSave && !ActorInfo.bColumnar && ISaveGameObject::Execute_CanReuseSaveData(Actor))
+		{
+			ActorInfo.PropertyHash = HashSaveGameState(Actor);
+		}
+
+		if (ActorInfo.PropertyHash.IsSet() && !DirtyActors.Contains(Actor))
+		{
+			FSaveGameActorCache* Cache = Subsystem->ActorCache.Find(Actor);
+
+#if USE_TEXT_FORMATTER
+			// Data cached by a save without JSON output can't be reused by one with it
+			if (bJsonOutput && Cache && Cache->Json.IsEmpty())
+			{
+				Cache = nullptr;
+			}
+#endif
+
+			if (Cache && Cache->PropertyHash == *ActorInfo.PropertyHash)
+			{
+				// Nothing has changed, the cached data will be spliced in when merging. The game thread is waiting
+				// on us, so the subsystem's cache can't change while it's copied
+				ActorInfo.Cache = *Cache;
+				return;
+			}
+		}
+
+		if (!ActorInfo.bLevelActor)
+		{
+			// We're a spawned actor, stash the class
+			ActorInfo.Class = Actor->GetClass();
+		}
+
+		if (Actor->Implements<USaveGameSpawnActor>())
+		{
+			ActorInfo.SpawnID = ISaveGameSpawnActor::Execute_GetSpawnID(Actor);
+		}
+
+		// Take our snapshot, the actor won't be touched again once this and its custom data have been captured
+		ActorInfo.Snapshot.Emplace(Actor, GetSnapshotLayout(Actor->GetClass()), Arena);
+
+		if (bForceSingleThreaded || ISaveGameObject::Execute_IsThreadSafe(Actor))
+		{
+			CaptureCustomData(ActorIdx);
+		}
+		else
+		{
+			// We're not threadsafe, queue up this actor to the game thread
+			ISaveGameThreadQueue::Get().AddTask([this, ActorIdx] { CaptureCustomData(ActorIdx); });
+		}
+
+		return;
+	}
+
+	// When loading, we already have the data, so reuse our level's data
+	ActorInfo.CreateArchive(Arena, Levels[ActorInfo.LevelIdx].Data, Redirects, GetNameTable());
+	ActorInfo.Archive->GetArchive().Seek(ActorInfo.Offset);
+	ActorInfo.Archive->ConsolidateVersions(*SaveArchive);
+
+	SerializeActorIdentity(ActorInfo);
+
+	ISaveGameThreadQueue::FTaskFunction SpawnOrGetActor = [this, ActorIdx]
+	{
+		UWorld* World = Subsystem->GetWorld();
+		FActorInfo& ActorInfo = ActorData[ActorIdx];
+		const FLevelInfo& LevelInfo = Levels[ActorInfo.LevelIdx];
+		TWeakObjectPtr<AActor>& Actor = ActorInfo.Actor;
+
+		if (ActorInfo.Class.IsNull())
+		{
+			ensureAlways(!ActorInfo.Name.IsEmpty());
+
+			// This is a loaded actor (is a level actor), let's find it
+			Actor = FindObjectFast<AActor>(LevelInfo.Level.Get(), *ActorInfo.Name);
+		}
+		else if (ActorInfo.SpawnID.IsValid() && SpawnIDs.Contains(ActorInfo.SpawnID))
+		{
+			Actor = SpawnIDs[ActorInfo.SpawnID];
+		}
+		else
+		{
+			UClass* ActorClass = ActorInfo.Class.TryLoadClass<AActor>();
+
+			ensureAlways(!ActorInfo.Name.IsEmpty());
+			ensureAlways(ActorClass);
+
+			// This is a spawned actor, let's spawn it
+			FActorSpawnParameters SpawnParameters;
+
+			SpawnParameters.OverrideLevel = LevelInfo.Level.Get();
+			SpawnParameters.Name = *ActorInfo.Name;
+			SpawnParameters.bNoFail = true;
+
+			Actor = World->SpawnActor(ActorClass, nullptr, nullptr, SpawnParameters);
+
+			if (ActorInfo.SpawnID.IsValid() && Actor->Implements<USaveGameSpawnActor>())
+			{
+				ISaveGameSpawnActor::Execute_SetSpawnID(Actor.Get(), ActorInfo.SpawnID);
+			}
+		}
+
+		check(Actor.IsValid());
+
+		if (ActorInfo.SpawnID.IsValid())
+		{
+			const FString ActorSubPath = LEVEL_SUBPATH_PREFIX + ActorInfo.Name;
+
+			// We potentially have a spawned actor that other actors reference
+			// If the name has changed, be sure to redirect the old actor path to the new one
+			ActorInfo.Archive->GetArchive().AddRedirect(FSoftObjectPath(LevelInfo.LevelAssetPath, ActorSubPath),
+			                                            FSoftObjectPath(Actor.Get()));
+		}
+	};
+
+	if (bForceSingleThreaded)
+	{
+		SpawnOrGetActor();
+	}
+	else
+	{
+		ISaveGameThreadQueue::Get().AddTask(Forward<ISaveGameThreadQueue::FTaskFunction>(SpawnOrGetActor));
+	}
+}
+
+template <bool bIsLoading>
+void TSaveGameSerializer<bIsLoading>::SerializeActorIdentity(FActorInfo& ActorInfo)
+{
+	FStructuredArchive::FRecord& Record = ActorInfo.Archive->GetRecord();
+	Record.EnterField(TEXT("Name")) << ActorInfo.Name;
+
+	ensureAlways(!ActorInfo.Name.IsEmpty());
+
+	// If we have a class, we're a spawned actor
+	if (TOptional<FStructuredArchive::FSlot> ClassSlot = Record.TryEnterField(TEXT("Class"), !ActorInfo.Class.IsNull()))
+	{
+		ClassSlot.GetValue() << ActorInfo.Class;
+
+		// Our class is part of what the save needs loaded before its actors are spawned
+		if (!bIsLoading)
+		{
+			GetNameTable()->AddObjectPath(ActorInfo.Class);
+		}
+	}
+
+	// If we have a GUID, we're a spawn actor that needs to be mapped by GUID
+	if (TOptional<FStructuredArchive::FSlot> GuidSlot = Record.TryEnterField(TEXT("GUID"), ActorInfo.SpawnID.IsValid()))
+	{
+		GuidSlot.GetValue() << ActorInfo.SpawnID;
+	}
+}
+
+template <bool bIsLoading>
+const FSaveGamePropertySnapshotLayout& TSaveGameSerializer<bIsLoading>::GetSnapshotLayout(const UClass* Class)
+{
+	const FObjectKey ClassKey(Class);
+
+	{
+		FReadScopeLock ReadLock(SnapshotLayoutsLock);
+		if (const TUniquePtr<FSaveGamePropertySnapshotLayout>* Layout = SnapshotLayouts.Find(ClassKey))
+		{
+			return **Layout;
+		}
+	}
+
+	// Another actor of the class may have added it while we were waiting for the lock
+	FWriteScopeLock WriteLock(SnapshotLayoutsLock);
+	TUniquePtr<FSaveGamePropertySnapshotLayout>& Layout = SnapshotLayouts.FindOrAdd(ClassKey);
+
+	if (!Layout.IsValid())
+	{
+		Layout = MakeUnique<FSaveGamePropertySnapshotLayout>(Class);
+	}
+
+	return *Layout;
+}
+
+template <bool bIsLoading>
+void TSaveGameSerializer<bIsLoading>::CaptureCustomData(int32 ActorIdx)
+{
+	check(!bIsLoading);
+
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_OnSerialize);
+
+	FActorInfo& ActorInfo = ActorData[ActorIdx];
+	AActor* Actor = ActorInfo.Actor.Get();
+
+	// Written to its own archive, as it's the same as the "Data" record that it will be spliced into
+	ActorInfo.CreateCustomDataArchive(Arena, Redirects, GetNameTable(), bJsonOutput);
+
+	{
+		// Encapsulate the record in something a Blueprint can access
+		FSaveGameArchive SaveGameArchive(ActorInfo.CustomDataArchive->GetRecord(), Actor);
+
+		ISaveGameObject::Execute_OnSerialize(Actor, SaveGameArchive, bIsLoading);
+	}
+
+	ActorInfo.CustomDataArchive->Close();
+}
+
+template <bool bIsLoading>
+void TSaveGameSerializer<bIsLoading>::SerializeActor(int32 ActorIdx)
+{
+	check(bForceSingleThreaded || !IsInGameThread());
+
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SerializeScriptProperties);
+
+	FActorInfo& ActorInfo = ActorData[ActorIdx];
+
+	if (!bIsLoading)
+	{
+		// Nothing to serialize if we're reusing cached data, or the actor was destroyed since the save started
+		if (ActorInfo.Cache.IsSet() || !ActorInfo.Snapshot)
+		{
+			ActorInfo.SerializedEvent.Trigger();
+			return;
+		}
+
+		{
+			// Garbage collection can't be allowed to release (or null out) what our snapshot references meanwhile
+			FGCScopeGuard GCGuard;
+
+			ActorInfo.CreateArchive(Arena, ActorInfo.Data, Redirects, GetNameTable(), bJsonOutput);
+			SerializeActorIdentity(ActorInfo);
+
+			FStructuredArchive::FRecord& Record = ActorInfo.Archive->GetRecord();
+
+			// Any UPROPERTY marker with "Savegame" will get stored in here, unless it's in our level's column group
+			// (whose snapshots are kept until the group is serialized)
+			TOptional<FStructuredArchive::FSlot> PropertiesSlot = Record.TryEnterField(TEXT("Properties"),
+			                                                                           !ActorInfo.bColumnar);
+			if (PropertiesSlot)
+			{
+				ActorInfo.Snapshot->Serialize(PropertiesSlot.GetValue());
+				ActorInfo.Snapshot.Reset();
+			}
+		}
+
+		FStructuredArchive::FRecord& Record = ActorInfo.Archive->GetRecord();
+
+#if USE_TEXT_FORMATTER
+		if (FJsonOutputArchiveFormatter* JsonFormatter = ActorInfo.Archive->GetJsonFormatter())
+		{
+			// Text formatters would store the spliced bytes as a blob, so give them the record's JSON instead
+			JsonFormatter->SpliceNextBlob(ActorInfo.CustomDataArchive->GetJsonFormatter()->GetText());
+		}
+#endif
+
+		// The custom data was written as a record, so its bytes can be spliced in as this actor's "Data" record
+		Record.EnterField(TEXT("Data")).Serialize(ActorInfo.CustomData.GetData(), ActorInfo.CustomData.Num());
+		ActorInfo.Archive->ConsolidateVersions(*ActorInfo.CustomDataArchive);
+
+		ActorInfo.ReleaseCustomData();
+
+		// Our actor's data is complete, it can now be merged
+		ActorInfo.SerializedEvent.Trigger();
+		return;
+	}
+
+	const AActor* Actor = ActorInfo.Actor.Get();
+	FStructuredArchive::FRecord& Record = ActorInfo.Archive->GetRecord();
+
+	/* Since we have control of the game thread, we should be pretty safe to serialize our properties
+	 * Any UPROPERTY marker with "Savegame" will get stored in here, unless it was in our level's column group */
+	if (Archive.CustomVer(FSaveGameVersion::GUID) < FSaveGameVersion::ColumnGroups)
+	{
+		Actor->SerializeScriptProperties(Record.EnterField(TEXT("Properties")));
+	}
+	else if (TOptional<FStructuredArchive::FSlot> PropertiesSlot = Record.TryEnterField(TEXT("Properties"), false))
+	{
+		Actor->SerializeScriptProperties(PropertiesSlot.GetValue());
+	}
+
+	ISaveGameThreadQueue::FTaskFunction CallOnSerialize = [this, ActorIdx]
+	{
+		QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_OnSerialize);
 
-	ActorOffsets.SetNumZeroed(NumActors);
-	ActorOffsetsOffset = Archive.Tell();
-	Archive << ActorOffsets;
+		FActorInfo& ActorInfo = ActorData[ActorIdx];
 
-	// We do this as in a load game, we will have the number of actors from the actor offets
-	NumActors = ActorOffsets.Num();
-	SaveGameActors.SetNumZeroed(NumActors);
-	ActorData.SetNumZeroed(NumActors);
+		{
+			AActor* Actor = ActorInfo.Actor.Get();
+			FStructuredArchive::FRecord& Record = ActorInfo.Archive->GetRecord();
+			FStructuredArchive::FSlot CustomDataSlot = Record.EnterField(TEXT("Data"));
+			FStructuredArchive::FRecord CustomDataRecord = CustomDataSlot.EnterRecord();
 
-	ActorsOffset = Archive.Tell();
-	FStructuredArchive::FStream ActorStream = SaveArchive->GetRecord().EnterStream(TEXT("Actors"));
+			// Encapsulate the record in something a Blueprint can access
+			FSaveGameArchive SaveGameArchive(CustomDataRecord, Actor);
 
-	// Need to init actors first for the sake of populating redirects before serialization
-	{
-		QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_InitializeActors);
+			ISaveGameObject::Execute_OnSerialize(Actor, SaveGameArchive, bIsLoading);
+		}
 
-		ExecuteJobs(NumActors, GET_STATID(STAT_SaveGame_InitializeActors),
-		            [this](int32 ActorIdx) { InitializeActor(ActorIdx); });
-	}
+		// Our actor's data is complete, it can now be merged
+		ActorInfo.SerializedEvent.Trigger();
+	};
 
-	// Actually do the serialization of each actor (now that we've updated redirects)
+	if (bForceSingleThreaded || ISaveGameObject::Execute_IsThreadSafe(Actor))
 	{
-		QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_Serialize);
-
-		ExecuteJobs(NumActors, GET_STATID(STAT_SaveGame_Serialize),
-		            [this](int32 ActorIdx) { SerializeActor(ActorIdx); });
+		CallOnSerialize();
 	}
-
-	if (bIsLoading)
+	else
 	{
-		for (FActorInfo& ActorInfo : ActorData)
-		{
-			ActorInfo.Archive->Close();
-		}
+		// We're not threadsafe, queue up this actor to the game thread
+		ISaveGameThreadQueue::Get().AddTask(Forward<ISaveGameThreadQueue::FTaskFunction>(CallOnSerialize));
 	}
 }
 
 template <bool bIsLoading>
-void TSaveGameSerializer<bIsLoading>::InitializeActor(int32 ActorIdx)
+void TSaveGameSerializer<bIsLoading>::MergeSaveData()
 {
-	const FString EventStr = FString::Printf(TEXT("InitializeActor: %i"), ActorIdx);
-	SCOPED_NAMED_EVENT_FSTRING(EventStr, FColor::Red);
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_MergeThreadData);
 
-	FSoftClassPath Class;
-	FGuid SpawnID;
-	FActorInfo& ActorInfo = ActorData[ActorIdx];
+	MergeState = MakeUnique<FMergeState>();
+	MergeState->LevelStream.Emplace(SaveArchive->GetRecord().EnterStream(TEXT("Levels")));
 
-	if (bIsLoading)
+	MergeLevel(0);
+}
+
+template <bool bIsLoading>
+void TSaveGameSerializer<bIsLoading>::MergeLevel(int32 LevelIdx)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_MergeLevel);
+
+	// Pending levels have nothing of ours to merge, only the chunks that were kept
+	while (LevelIdx < Levels.Num() && Levels[LevelIdx].Carried.IsSet())
 	{
-		// When loading, we already have the data, so reuse our current data
-		ActorInfo.CreateArchive(Data, Redirects);
-		ActorInfo.Archive->GetArchive().Seek(ActorOffsets[ActorIdx]);
-		ActorInfo.Archive->ConsolidateVersions(*SaveArchive);
+		WriteCarriedLevel(Levels[LevelIdx++]);
 	}
-	else
+
+	if (LevelIdx == Levels.Num())
 	{
-		AActor* Actor = SaveGameActors[ActorIdx].Get();
-		ActorInfo.Actor = Actor;
-		ActorInfo.Name = Actor->GetName();
+		// The subsystem's cache is only changed on the game thread, which is where its world is torn down. Our merge
+		// isn't done until it has been handed over, so that the next save sees it. Level snapshots don't cache, and
+		// the game thread is waiting on them
+		if (!LevelToSnapshot)
+		{
+			AddNested(LaunchGameThread(UE_SOURCE_LOCATION, [this, ActorCache = MoveTemp(MergeState->ActorCache)]() mutable
+			{
+				HandOffActorCache(MoveTemp(ActorCache));
+			}));
+		}
+
+		MergeState.Reset();
+
+		// The versions are also kept in their own block when using a dictionary
+		StreamSaveData(UsesDictionary());
+		return;
+	}
+
+	FLevelInfo& LevelInfo = Levels[LevelIdx];
 
-		// When saving, we need to dump the data into
-		ActorInfo.CreateArchive(ActorInfo.Data, Redirects);
+	// Actors in column groups are referenced by their index among the level's stored actors
+	TMap<const UClass*, int32> ColumnGroupIndices;
+	int32 NumStoredActors = 0;
+
+	for (int32 LevelActorIdx = 0; LevelActorIdx < LevelInfo.NumActors; ++LevelActorIdx)
+	{
+		const int32 ActorIdx = LevelInfo.FirstActorIdx + LevelActorIdx;
+		FActorInfo& ActorInfo = ActorData[ActorIdx];
+		ActorInfo.SerializedEvent.Wait();
 
-		if (!USaveGameFunctionLibrary::WasObjectLoaded(ActorInfo.Actor.Get()))
+		if (!ActorInfo.Archive && !ActorInfo.Cache.IsSet())
 		{
-			// We're a spawned actor, stash the class
-			Class = Actor->GetClass();
+			// When time slicing, level actors can be destroyed mid save, so they need to be in the level's header
+			if (ActorInfo.bLevelActor)
+			{
+				LevelInfo.DestroyedActors.AddUnique(*ActorInfo.Name);
+			}
+
+			continue;
 		}
 
-		if (Actor->Implements<USaveGameSpawnActor>())
+		if (ActorInfo.bColumnar)
 		{
-			SpawnID = ISaveGameSpawnActor::Execute_GetSpawnID(Actor);
+			const UClass* Class = ActorInfo.Snapshot->GetClass();
+			int32& GroupIdx = ColumnGroupIndices.FindOrAdd(Class, INDEX_NONE);
+
+			if (GroupIdx == INDEX_NONE)
+			{
+				GroupIdx = LevelInfo.ColumnGroups.AddDefaulted();
+				LevelInfo.ColumnGroups[GroupIdx].Class = FSoftClassPath(Class);
+			}
+
+			LevelInfo.ColumnGroups[GroupIdx].Rows.Add(NumStoredActors);
+			LevelInfo.ColumnGroups[GroupIdx].ActorIndices.Add(ActorIdx);
 		}
+
+		++NumStoredActors;
 	}
-	FStructuredArchive::FRecord& Record = ActorInfo.Archive->GetRecord();
-	Record.EnterField(TEXT("Name")) << ActorInfo.Name;
 
-	ensureAlways(!ActorInfo.Name.IsEmpty());
+	// Rather than waiting on its column groups, the rest of the level is merged once they've been serialized
+	const FTask ColumnGroupsTask = LaunchJobs(LevelInfo.ColumnGroups.Num(), GET_STATID(STAT_SaveGame_SerializeColumnGroups),
+		[this, &LevelInfo](int32 JobIdx) { SerializeColumnGroup(LevelInfo.ColumnGroups[JobIdx]); });
 
-	// If we have a class, we're a spawned actor
-	if (TOptional<FStructuredArchive::FSlot> ClassSlot = Record.TryEnterField(TEXT("Class"), !Class.IsNull()))
+	AddNested(Launch(UE_SOURCE_LOCATION, [this, LevelIdx]
 	{
-		ClassSlot.GetValue() << Class;
-	}
+		WriteMergedLevel(LevelIdx);
+		MergeLevel(LevelIdx + 1);
+	}, ColumnGroupsTask));
+}
 
-	// If we have a GUID, we're a spawn actor that needs to be mapped by GUID
-	if (TOptional<FStructuredArchive::FSlot> GuidSlot = Record.TryEnterField(TEXT("GUID"), SpawnID.IsValid()))
+template <bool bIsLoading>
+void TSaveGameSerializer<bIsLoading>::WriteMergedLevel(int32 LevelIdx)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_WriteMergedLevel);
+
+	FLevelInfo& LevelInfo = Levels[LevelIdx];
+
+#if USE_TEXT_FORMATTER
+	FJsonOutputArchiveFormatter* JsonFormatter = SaveArchive->GetJsonFormatter();
+#endif
+
+	for (const FColumnGroup& Group : LevelInfo.ColumnGroups)
 	{
-		GuidSlot.GetValue() << SpawnID;
+		SaveArchive->ConsolidateVersions(Group.Versions);
 	}
 
-	if (bIsLoading)
-	{
-		ISaveGameThreadQueue::FTaskFunction SpawnOrGetActor = [this, ActorIdx, Class, SpawnID]
-		{
-			UWorld* World = Subsystem->GetWorld();
-			FActorInfo& ActorInfo = ActorData[ActorIdx];
-			TWeakObjectPtr<AActor>& Actor = ActorInfo.Actor;
+	// Each level chunk starts a new block when using a dictionary, so that they can be decompressed separately
+	StreamSaveData(UsesDictionary());
 
-			if (Class.IsNull())
-			{
-				ensureAlways(!ActorInfo.Name.IsEmpty());
+	LevelInfo.Offset = GetArchiveOffset();
+	LevelInfo.ActorOffsets.Reset(LevelInfo.NumActors);
 
-				// This is a loaded actor (is a level actor), let's find it
-				Actor = FindObjectFast<AActor>(World->GetCurrentLevel(), *ActorInfo.Name);
-			}
-			else if (SpawnID.IsValid() && SpawnIDs.Contains(SpawnID))
-			{
-				Actor = SpawnIDs[SpawnID];
-			}
-			else
-			{
-				UClass* ActorClass = Class.TryLoadClass<AActor>();
+	FStructuredArchive::FRecord LevelRecord = MergeState->LevelStream->EnterElement().EnterRecord();
+	SerializeLevelHeader(LevelRecord, LevelInfo);
 
-				ensureAlways(!ActorInfo.Name.IsEmpty());
-				ensureAlways(ActorClass);
+	FStructuredArchive::FStream ActorStream = LevelRecord.EnterStream(TEXT("Actors"));
 
-				// This is a spawned actor, let's spawn it
-				FActorSpawnParameters SpawnParameters;
+	// Merge each actor's save data
+	for (int32 LevelActorIdx = 0; LevelActorIdx < LevelInfo.NumActors; ++LevelActorIdx)
+	{
+		FActorInfo& ActorInfo = ActorData[LevelInfo.FirstActorIdx + LevelActorIdx];
 
-				// If we were handling levels, specify it here
-				SpawnParameters.OverrideLevel = World->GetCurrentLevel();
-				SpawnParameters.Name = *ActorInfo.Name;
-				SpawnParameters.bNoFail = true;
+		if (!ActorInfo.Archive && !ActorInfo.Cache.IsSet())
+		{
+			// Destroyed since the save started
+			continue;
+		}
 
-				Actor = World->SpawnActor(ActorClass, nullptr, nullptr, SpawnParameters);
+		// As do actors, which are small enough to compress well with a dictionary
+		StreamSaveData(UsesDictionary());
+		LevelInfo.ActorOffsets.Add(IntCastChecked<uint32>(GetArchiveOffset() - LevelInfo.Offset));
 
-				if (SpawnID.IsValid() && Actor->Implements<USaveGameSpawnActor>())
-				{
-					ISaveGameSpawnActor::Execute_SetSpawnID(Actor.Get(), SpawnID);
-				}
+		if (ActorInfo.Cache.IsSet())
+		{
+			SaveArchive->ConsolidateVersions(ActorInfo.Cache->Versions);
+
+#if USE_TEXT_FORMATTER
+			if (JsonFormatter)
+			{
+				JsonFormatter->SerializeJson(ActorInfo.Cache->Json);
 			}
+#endif
 
-			check(Actor.IsValid());
-			SaveGameActors[ActorIdx] = Actor;
+			StreamBuffer(ActorInfo.Cache->Data);
 
-			if (SpawnID.IsValid())
-			{
-				const FString ActorSubPath = LEVEL_SUBPATH_PREFIX + ActorInfo.Name;
+			// Move our copy of the cached data over, as it's still valid
+			MergeState->ActorCache.Add(ActorInfo.Actor, MoveTemp(ActorInfo.Cache.GetValue()));
+			continue;
+		}
 
-				// We potentially have a spawned actor that other actors reference
-				// If the name has changed, be sure to redirect the old actor path to the new one
-				ActorInfo.Archive->GetArchive().AddRedirect(FSoftObjectPath(LevelAssetPath, ActorSubPath),
-				                                            FSoftObjectPath(Actor.Get()));
-			}
-		};
+		ActorInfo.Archive->Close();
+		SaveArchive->ConsolidateVersions(*ActorInfo.Archive);
 
-		if (bForceSingleThreaded)
+#if USE_TEXT_FORMATTER
+		// Append our JSON to the main Save Game archive's
+		FJsonOutputArchiveFormatter* ActorJsonFormatter = ActorInfo.Archive->GetJsonFormatter();
+		if (JsonFormatter)
 		{
-			SpawnOrGetActor();
+			JsonFormatter->SerializeJson(ActorJsonFormatter->GetText());
 		}
-		else
+#endif
+
+		// The actor's data is handed to the container as is, rather than being appended to ours
+		const FSharedBuffer ActorBuffer = MakeSharedBufferFromArray(MoveTemp(ActorInfo.Data));
+		StreamBuffer(ActorBuffer);
+
+		if (ActorInfo.PropertyHash.IsSet())
 		{
-			ISaveGameThreadQueue::Get().AddTask(Forward<ISaveGameThreadQueue::FTaskFunction>(SpawnOrGetActor));
+			FSaveGameActorCache& Cache = MergeState->ActorCache.Add(ActorInfo.Actor);
+			Cache.PropertyHash = *ActorInfo.PropertyHash;
+			// The cache is kept until the next save, so it gets its own copy rather than holding on to arena blocks
+			Cache.Data = FSharedBuffer::Clone(ActorBuffer.GetView());
+			Cache.Versions = ActorInfo.Archive->GetArchive().GetCustomVersions();
+#if USE_TEXT_FORMATTER
+			if (ActorJsonFormatter)
+			{
+				Cache.Json = ActorJsonFormatter->ReleaseText();
+			}
+#endif
 		}
 	}
+
+	AddLevelSection(LevelInfo);
+
+	// The columns have been streamed, they're no longer needed
+	LevelInfo.ColumnGroups.Empty();
 }
 
 template <bool bIsLoading>
-void TSaveGameSerializer<bIsLoading>::SerializeActor(int32 ActorIdx)
+void TSaveGameSerializer<bIsLoading>::WriteCarriedLevel(FLevelInfo& LevelInfo)
 {
-	check(bForceSingleThreaded || !IsInGameThread());
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_WriteCarriedLevel);
 
-	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SerializeScriptProperties);
+	const FSaveGamePendingLevel& PendingLevel = LevelInfo.Carried.GetValue();
 
-	FActorInfo& ActorInfo = ActorData[ActorIdx];
-	const AActor* Actor = ActorInfo.Actor.Get();
-	FStructuredArchive::FRecord& Record = ActorInfo.Archive->GetRecord();
+	StreamSaveData(UsesDictionary());
+	LevelInfo.Offset = GetArchiveOffset();
 
-	/* Since we have control of the game thread, we should be pretty safe to serialize our properties
-	 * Any UPROPERTY marker with "Savegame" will get stored in here */
-	Actor->SerializeScriptProperties(Record.EnterField(TEXT("Properties")));
+	// Its names are in our name table and its versions are the latest (see SerializeLevels), so they're also ours
+	SaveArchive->ConsolidateVersions(PendingLevel.Context->Versions);
 
-	ISaveGameThreadQueue::FTaskFunction CallOnSerialize = [this, ActorIdx]
+#if USE_TEXT_FORMATTER
+	if (FJsonOutputArchiveFormatter* JsonFormatter = SaveArchive->GetJsonFormatter())
 	{
-		QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_OnSerialize);
-
-		FActorInfo& ActorInfo = ActorData[ActorIdx];
-		AActor* Actor = ActorInfo.Actor.Get();
-		FStructuredArchive::FRecord& Record = ActorInfo.Archive->GetRecord();
-		FStructuredArchive::FSlot CustomDataSlot = Record.EnterField(TEXT("Data"));
-		FStructuredArchive::FRecord CustomDataRecord = CustomDataSlot.EnterRecord();
-
-		// Encapsulate the record in something a Blueprint can access
-		FSaveGameArchive SaveGameArchive(CustomDataRecord, Actor);
+		// What the chunk holds can't be known without its level, so it's only named
+		const FTCHARToUTF8 Json(*FString::Printf(TEXT("{\"Name\": \"%s\", \"Carried\": true}"),
+		                                         *LevelInfo.LevelAssetPath.ToString()));
+		JsonFormatter->SerializeJson(MakeArrayView(reinterpret_cast<const uint8*>(Json.Get()), Json.Length()));
+	}
+#endif
 
-		ISaveGameObject::Execute_OnSerialize(Actor, SaveGameArchive, bIsLoading);
-	};
+	StreamBuffer(PendingLevel.Data);
+	LevelInfo.ActorOffsets = PendingLevel.ActorOffsets;
 
-	if (bForceSingleThreaded || ISaveGameObject::Execute_IsThreadSafe(Actor))
-	{
-		CallOnSerialize();
-	}
-	else
-	{
-		// We're not threadsafe, queue up this actor to the game thread
-		ISaveGameThreadQueue::Get().AddTask(Forward<ISaveGameThreadQueue::FTaskFunction>(CallOnSerialize));
-	}
+	AddLevelSection(LevelInfo);
+	LevelInfo.Carried.Reset();
 }
 
 template <bool bIsLoading>
-void TSaveGameSerializer<bIsLoading>::MergeSaveData()
+void TSaveGameSerializer<bIsLoading>::AddLevelSection(FLevelInfo& LevelInfo)
 {
-	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_MergeThreadData);
+	FSaveGameTableOfContents::FLevelSection& LevelSection = Toc.Levels.AddDefaulted_GetRef();
+	LevelSection.Name = LevelInfo.LevelAssetPath.ToString();
+	LevelSection.Offset = LevelInfo.Offset;
+	LevelSection.Size = GetArchiveOffset() - LevelInfo.Offset;
+	LevelSection.ActorOffsets = MoveTemp(LevelInfo.ActorOffsets);
+}
 
-	Archive.Seek(ActorsOffset);
-	FStructuredArchive::FStream ActorStream = SaveArchive->GetRecord().EnterStream(TEXT("Actors"));
+template <bool bIsLoading>
+void TSaveGameSerializer<bIsLoading>::OpenContainerWriter()
+{
+	const USaveGameSettings* Settings = GetDefault<USaveGameSettings>();
 
-	// Merge each actor's save data
-	for (int32 ActorIdx = 0; ActorIdx < ActorData.Num(); ++ActorIdx)
+	// Saves of the generic save game system are files, so they can be written (and streamed) to directly. Any other
+	// save game system is handed the whole container, as it's the only one that knows where (and how) to store it
+	if (Settings->bWriteBehindSaves && FSaveGameContainer::UsesGenericSaveGameSystem())
 	{
-		FActorInfo& ActorInfo = ActorData[ActorIdx];
-
-		ActorInfo.Archive->Close();
-		SaveArchive->ConsolidateVersions(*ActorInfo.Archive);
-
-		FStructuredArchive::FSlot StreamElement = ActorStream.EnterElement();
-
-#if USE_TEXT_FORMATTER
-		// Merge our JSON structure into the main Save Game archive's
-		FSaveGameArchiveFormatter& Formatter = reinterpret_cast<FSaveGameArchiveFormatter&>(SaveArchive->Formatter);
-		Formatter.JsonFormatter.Serialize(
-			reinterpret_cast<FSaveGameArchiveFormatter&>(ActorInfo.Archive->Formatter).JsonFormatter.GetRoot());
-#endif
-
-		Archive.Seek(Data.Num());
+		FileWriter = MakeUnique<FSaveGameFileWriter>(FSaveGameContainer::GetFilePath(GetSaveName()));
 
-		uint64 DataSize = ActorInfo.Data.Num();
-		StreamElement.EnterAttribute(TEXT("DataSize")) << DataSize;
+		if (FileWriter->IsError())
+		{
+			FileWriter.Reset();
+		}
+	}
 
-		ActorOffsets[ActorIdx] = Data.Num();
+	if (!FileWriter.IsValid())
+	{
+		ContainerArchive = MakeUnique<FMemoryWriter>(ContainerData);
+	}
 
-		// We are appending the data, as serialising will prepend data on the length of the array
-		Data.Append(ActorInfo.Data);
+	// If we already have a map name, don't change it
+	if (LastVisitedMap.IsEmpty())
+	{
+		LastVisitedMap = Subsystem->GetWorld()->GetOutermost()->GetLoadedPath().GetPackageName();
 	}
 
-	ActorData.Empty();
+	Summary->Timestamp = FDateTime::UtcNow();
+	Summary->LastVisitedMap = LastVisitedMap;
+	Summary->EngineVersion = FEngineVersion::Current();
+	Subsystem->SetLastSaveTimestamp(Summary->Timestamp);
 
-	Archive.Seek(ActorOffsetsOffset);
-	Archive << ActorOffsets;
-	Archive.Seek(Data.Num());
+	if (FileWriter.IsValid())
+	{
+		ContainerWriter = MakeUnique<FSaveGameContainerWriter>(*FileWriter, *Summary,
+		                                                       Settings->CompressionFormat,
+		                                                       Settings->GetCompressionLevel(GetSaveName()),
+		                                                       Settings->CompressionBlockSizeKB * 1024,
+		                                                       FSaveGameCompressionDictionary::Get());
+	}
+	else
+	{
+		ContainerWriter = MakeUnique<FSaveGameContainerWriter>(*ContainerArchive, *Summary,
+		                                                       Settings->CompressionFormat,
+		                                                       Settings->GetCompressionLevel(GetSaveName()),
+		                                                       Settings->CompressionBlockSizeKB * 1024,
+		                                                       FSaveGameCompressionDictionary::Get());
+	}
 }
 
 template <bool bIsLoading>
-void TSaveGameSerializer<bIsLoading>::SerializeDestroyedActors()
+void TSaveGameSerializer<bIsLoading>::StreamSaveData(bool bEndBlock)
 {
-	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SerializeDestroyedActors);
+	check(!bIsLoading);
 
-	check(IsInGameThread());
-	const UWorld* World = Subsystem->GetWorld();
+	// Start our data again, the offsets of anything that follows will include what was streamed
+	StreamedSize += Data.Num();
 
-	int32 NumDestroyedActors;
+	if (LevelToSnapshot)
+	{
+		SnapshotData.Append(Data);
+		Data.Reset();
+	}
+	else if (!Data.IsEmpty())
+	{
+		ContainerWriter->Write(MakeSharedBufferFromArray(MoveTemp(Data)));
+	}
 
-	if (!bIsLoading)
+	if (bEndBlock && ContainerWriter)
 	{
-		NumDestroyedActors = Subsystem->DestroyedLevelActors.Num();
+		ContainerWriter->Flush();
 	}
 
-	FStructuredArchive::FArray DestroyedActorsArray = SaveArchive->GetRecord().EnterArray(
-		TEXT("DestroyedActors"), NumDestroyedActors);
+	Archive.Seek(0);
+}
+
+template <bool bIsLoading>
+void TSaveGameSerializer<bIsLoading>::StreamBuffer(const FSharedBuffer& Buffer)
+{
+	check(!bIsLoading);
+	checkf(Data.IsEmpty(), TEXT("Stream our own data first, so that the buffer is written after it"));
 
-	if (bIsLoading)
+	if (LevelToSnapshot)
 	{
-		// Allocate our expected number of actors
-		Subsystem->DestroyedLevelActors.Reset();
-		Subsystem->DestroyedLevelActors.Reserve(NumDestroyedActors);
+		SnapshotData.Append(static_cast<const uint8*>(Buffer.GetData()), IntCastChecked<int32>(Buffer.GetSize()));
 	}
-
-	auto DestroyedActorsIt = Subsystem->DestroyedLevelActors.CreateConstIterator();
-	for (int32 ActorIdx = 0; ActorIdx < NumDestroyedActors; ++ActorIdx)
+	else
 	{
-		FName ActorName;
+		ContainerWriter->Write(Buffer);
+	}
 
-		if (!bIsLoading)
-		{
-			// Only store the object name without the prefix and full path
-			FString ActorSubPath = (*DestroyedActorsIt).GetSubPathString();
-			ActorSubPath.RemoveFromStart(LEVEL_SUBPATH_PREFIX);
-			ActorName = *ActorSubPath;
+	StreamedSize += Buffer.GetSize();
+}
 
-			++DestroyedActorsIt;
-		}
+template <bool bIsLoading>
+void TSaveGameSerializer<bIsLoading>::ApplyDestroyedActors(const FLevelInfo& LevelInfo)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_ApplyDestroyedActors);
 
-		DestroyedActorsArray.EnterElement() << ActorName;
+	check(IsInGameThread());
 
-		if (bIsLoading)
+	for (const FName& ActorName : LevelInfo.DestroyedActors)
+	{
+		// Find the live actor in the level
+		if (AActor* DestroyedActor = FindObjectFast<AActor>(LevelInfo.Level.Get(), ActorName))
 		{
-			// Find the live actor in the level
-			if (AActor* DestroyedActor = FindObjectFast<AActor>(World->GetCurrentLevel(), ActorName))
-			{
-				// Be sure to add any valid destroyed actors back into the array for saving later!
-				Subsystem->DestroyedLevelActors.Add(DestroyedActor);
-				DestroyedActor->Destroy();
-			}
+			// Be sure to add any valid destroyed actors back into the array for saving later!
+			Subsystem->DestroyedLevelActors.Add(DestroyedActor);
+			DestroyedActor->Destroy();
+		}
+		else if (!LevelInfo.Level.IsValid())
+		{
+			// The level isn't resident, keep it around so that it's destroyed when it's saved again
+			Subsystem->DestroyedLevelActors.Add(
+				FSoftObjectPath(LevelInfo.LevelAssetPath, LEVEL_SUBPATH_PREFIX + ActorName.ToString()));
 		}
 	}
 }
@@ -749,17 +2618,22 @@ void TSaveGameSerializer<bIsLoading>::SerializeVersions()
 
 	if (bIsLoading)
 	{
-		Archive.Seek(VersionOffset);
+		Archive.Seek(Toc.Versions.Offset);
 	}
 	else
 	{
 		// Grab a copy of our archive's current versions
 		VersionContainer = Archive.GetCustomVersions();
-		VersionOffset = Archive.Tell();
+		Toc.Versions.Offset = GetArchiveOffset();
 	}
 
 	VersionContainer.Serialize(SaveArchive->GetRecord().EnterField(TEXT("Versions")));
 
+	if (!bIsLoading)
+	{
+		Toc.Versions.Size = GetArchiveOffset() - Toc.Versions.Offset;
+	}
+
 	if (bIsLoading)
 	{
 		// Assign our serialized versions
@@ -770,6 +2644,138 @@ void TSaveGameSerializer<bIsLoading>::SerializeVersions()
 	}
 }
 
+template <bool bIsLoading>
+void TSaveGameSerializer<bIsLoading>::HandOffActorCache(TMap<TWeakObjectPtr<AActor>, FSaveGameActorCache>&& ActorCache)
+{
+	check(!bIsLoading && IsInGameThread());
+
+	// If the world changed while we were saving, the subsystem has already dropped what was cached for it
+	if (Subsystem->GetWorld() == SavedWorld.Get())
+	{
+		Subsystem->ActorCache = MoveTemp(ActorCache);
+	}
+}
+
+template <bool bIsLoading>
+void TSaveGameSerializer<bIsLoading>::FailLoad(const FString& Reason)
+{
+	check(bIsLoading);
+
+	UE_LOG(LogSaveGameSerializer, Error, TEXT("%s: Couldn't load, %s"), *GetSaveName(), *Reason);
+	bLoadFailed = true;
+}
+
+template <bool bIsLoading>
+void TSaveGameSerializer<bIsLoading>::SerializeNameTable()
+{
+	check(!bIsLoading);
+
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SerializeNameTable);
+
+	// Written to the data directly, as its names are the ones that every other archive references
+	Toc.Names.Offset = GetArchiveOffset();
+	GetNameTable()->Serialize(Archive, FSaveGameContainer::LatestVersion);
+	Toc.Names.Size = GetArchiveOffset() - Toc.Names.Offset;
+}
+
+template <bool bIsLoading>
+void TSaveGameSerializer<bIsLoading>::SetPendingLevel(FSaveGamePendingLevel&& PendingLevel)
+{
+	check(bIsLoading);
+
+	bLoadingPendingLevel = true;
+	LoadContext = PendingLevel.Context;
+	LoadNameTable = LoadContext->NameTable;
+
+	// Paths to the actors that the load renamed are redirected as they were when it was loaded
+	if (LoadContext->Redirects)
+	{
+		Redirects.Append(*LoadContext->Redirects);
+	}
+
+	// Our archive stands in for the save that the level came from, which its own archive takes its versions from
+	Archive.SetUEVer(LoadContext->PackageVersion);
+	Archive.SetEngineVer(LoadContext->EngineVersion);
+	Archive.SetCustomVersions(LoadContext->Versions);
+
+	// Copied, as a save that's being written may be carrying it over
+	Levels.SetNum(1);
+	Levels[0].Data = TArray<uint8>(static_cast<const uint8*>(PendingLevel.Data.GetData()),
+	                               IntCastChecked<int32>(PendingLevel.Data.GetSize()));
+	Toc.Levels.AddDefaulted_GetRef().ActorOffsets = MoveTemp(PendingLevel.ActorOffsets);
+}
+
+template <bool bIsLoading>
+TSharedPtr<FSaveGameLoadContext> TSaveGameSerializer<bIsLoading>::GetLoadContext()
+{
+	check(bIsLoading);
+
+	if (!LoadContext)
+	{
+		LoadContext = MakeShared<FSaveGameLoadContext>();
+		LoadContext->SaveName = GetSaveName();
+		LoadContext->PackageVersion = Archive.UEVer();
+		LoadContext->EngineVersion = Archive.EngineVer();
+		LoadContext->Versions = Archive.GetCustomVersions();
+		LoadContext->NameTable = LoadNameTable;
+		LoadContext->Redirects = MakeShared<FSaveGameRedirects>();
+		LoadContext->bLatestVersions = IsLatestVersions(LoadContext->PackageVersion, LoadContext->Versions);
+	}
+
+	return LoadContext;
+}
+
+template <bool bIsLoading>
+FSaveGamePendingLevel TSaveGameSerializer<bIsLoading>::SnapshotLevel()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SnapshotLevel);
+
+	check(!bIsLoading && LevelToSnapshot && IsInGameThread());
+
+	SerializeLevels();
+	SnapshotReferencer = MakeUnique<FSnapshotReferencer>(ActorData);
+
+	// Nothing that follows the snapshots needs the game thread, so it can wait for them to be serialized and merged
+	const FTask SerializedTask = SerializeActors(0, ActorData.Num());
+	Launch(UE_SOURCE_LOCATION, [this] { MergeSaveData(); }, SerializedTask).Wait();
+
+	SaveArchive->Close();
+	SnapshotReferencer.Reset();
+	ActorData.Empty();
+	Arena.BulkDelete();
+
+	// Our data is the level's chunk, as nothing else was written
+	check(Toc.Levels.Num() == 1);
+	const FSaveGameTableOfContents::FLevelSection& LevelSection = Toc.Levels[0];
+	check(LevelSection.Offset == 0 && LevelSection.Size == static_cast<uint64>(SnapshotData.Num()));
+
+	FSaveGamePendingLevel PendingLevel;
+	PendingLevel.Data = MakeSharedBufferFromArray(MoveTemp(SnapshotData));
+	PendingLevel.ActorOffsets = LevelSection.ActorOffsets;
+
+	// Written by this build, with the subsystem's name table
+	PendingLevel.Context = MakeShared<FSaveGameLoadContext>();
+	PendingLevel.Context->SaveName = GetSaveName();
+	PendingLevel.Context->PackageVersion = GPackageFileUEVersion;
+	PendingLevel.Context->EngineVersion = FEngineVersion::Current();
+	PendingLevel.Context->Versions = Archive.GetCustomVersions();
+	PendingLevel.Context->NameTable = SaveNameTable;
+	PendingLevel.Context->bLatestVersions = true;
+
+	return PendingLevel;
+}
+
+template <bool bIsLoading>
+FSaveGameNameTable* TSaveGameSerializer<bIsLoading>::GetNameTable()
+{
+	if (bIsLoading)
+	{
+		return LoadNameTable.Get();
+	}
+
+	return SaveNameTable.Get();
+}
+
 // Instantiate the permutations of TSaveGameSerializer
 template TSaveGameSerializer<false>;
 template TSaveGameSerializer<true>;
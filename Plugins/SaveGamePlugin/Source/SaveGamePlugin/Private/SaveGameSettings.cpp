@@ -2,29 +2,103 @@
 
 #include "SaveGameSettings.h"
 
+#include "Algo/AllOf.h"
+#include "Async/Fundamental/Scheduler.h"
+
 FGuid USaveGameSettings::GetVersionId(const UEnum* VersionEnum) const
+{
+	const FVersionIds* VersionIds = PublishedVersions.load(std::memory_order_acquire);
+
+	// Only if used outside of a save or load
+	if (VersionIds == nullptr)
+	{
+		PublishVersions();
+		VersionIds = PublishedVersions.load(std::memory_order_acquire);
+	}
+
+	const FGuid* VersionId = VersionIds->Find(VersionEnum);
+	return VersionId ? *VersionId : FGuid();
+}
+
+void USaveGameSettings::PublishVersions() const
 {
 	FScopeLock Lock(&VersionsSection);
 
-	if (CachedVersions.IsEmpty())
+	if (!bVersionsChanged)
 	{
-		CachedVersions.Reserve(Versions.Num());
+		return;
+	}
+
+	TUniquePtr<FVersionIds> VersionIds = MakeUnique<FVersionIds>();
+	VersionIds->Reserve(Versions.Num());
+
+	for (const FSaveGameVersionInfo& VersionInfo : Versions)
+	{
+		if (VersionInfo.ID.IsValid() && VersionInfo.Enum)
+		{
+			VersionIds->FindOrAdd(VersionInfo.Enum) = VersionInfo.ID;
+		}
+	}
+
+	PublishedVersions.store(VersionIds.Get(), std::memory_order_release);
+	VersionIdsHistory.Add(MoveTemp(VersionIds));
+	bVersionsChanged = false;
+}
+
+int32 USaveGameSettings::GetLatestVersion(const FGuid& VersionId) const
+{
+	check(IsInGameThread());
 
-		for (const FSaveGameVersionInfo& VersionInfo : Versions)
+	for (const FSaveGameVersionInfo& VersionInfo : Versions)
+	{
+		if (VersionInfo.ID == VersionId && VersionInfo.Enum)
 		{
-			if (VersionInfo.ID.IsValid() && VersionInfo.Enum)
-			{
-				CachedVersions.FindOrAdd(VersionInfo.Enum) = VersionInfo.ID;
-			}
+			// As used by USaveGameFunctionLibrary::UseCustomVersion
+			return VersionInfo.Enum->GetMaxEnumValue() - 1;
 		}
 	}
 
-	if (CachedVersions.Contains(VersionEnum))
+	return INDEX_NONE;
+}
+
+bool USaveGameSettings::IsAutosaveSlot(const FString& SlotName) const
+{
+	if (AutoSaveSlotName.IsEmpty())
+	{
+		return false;
+	}
+
+	// Only the names that GetAutosaveSlotName produces, so that manual slots sharing the prefix aren't autosaves
+	const FString Prefix = AutoSaveSlotName + TEXT("_");
+	if (!SlotName.StartsWith(Prefix))
 	{
-		return CachedVersions[VersionEnum];
+		return false;
 	}
 
-	return FGuid();
+	const FString SlotIdx = SlotName.RightChop(Prefix.Len());
+	return !SlotIdx.IsEmpty() && Algo::AllOf(SlotIdx, FChar::IsDigit)
+		&& GetAutosaveSlotName(FCString::Atoi(*SlotIdx)) == SlotName;
+}
+
+FString USaveGameSettings::GetAutosaveSlotName(int32 SlotIdx) const
+{
+	return FString::Printf(TEXT("%s_%i"), *AutoSaveSlotName, SlotIdx);
+}
+
+ESaveGameCompressionLevel USaveGameSettings::GetCompressionLevel(const FString& SlotName) const
+{
+	return IsAutosaveSlot(SlotName) ? AutosaveCompressionLevel : ManualSaveCompressionLevel;
+}
+
+double USaveGameSettings::GetTimeSliceBudget(const FString& SlotName) const
+{
+	return (IsAutosaveSlot(SlotName) ? AutosaveTimeSliceMs : ManualSaveTimeSliceMs) / 1000.0;
+}
+
+int32 USaveGameSettings::GetNumWorkers() const
+{
+	const int32 NumWorkers = FMath::Max(static_cast<int32>(LowLevelTasks::FScheduler::Get().GetNumWorkers()) - 1, 1);
+	return MaxWorkers > 0 ? FMath::Min(MaxWorkers, NumWorkers + 1) : NumWorkers;
 }
 
 #if WITH_EDITOR
@@ -34,8 +108,9 @@ void USaveGameSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyCh
 
 	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(USaveGameSettings, Versions))
 	{
+		// Published again when the next save or load starts
 		FScopeLock Lock(&VersionsSection);
-		CachedVersions.Reset();
+		bVersionsChanged = true;
 	}
 }
 #endif
@@ -0,0 +1,185 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "SaveGameSlotIndex.h"
+
+#include "SaveGameSystem.h"
+#include "SaveGameTypes.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSaveGameSlotIndex, Log, All);
+
+static constexpr uint32 SlotIndexTag = 0x53474958; // "SGIX"
+
+void FSaveGameSlotIndex::GetSlots(ISaveGameSystem* SaveSystem, int32 UserIndex, TArray<FSaveGameSlotInfo>& OutSlots)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_GetSlots);
+
+	FScopeLock ScopeLock(&Lock);
+
+	OutSlots.Reset();
+
+	TArray<FString> SaveNames;
+	if (!SaveSystem || !SaveSystem->GetSaveGameNames(SaveNames, UserIndex))
+	{
+		return;
+	}
+
+	LoadIndex();
+
+	TMap<FString, FEntry> PreviousEntries = MoveTemp(Entries);
+	TMap<FString, FEntry> PreviousUnindexedEntries = MoveTemp(UnindexedEntries);
+	bool bChanged = false;
+
+	for (const FString& SaveName : SaveNames)
+	{
+		// JSON copies of saves are for debugging, and aren't containers
+		if (SaveName.EndsWith(TEXT(".json")))
+		{
+			continue;
+		}
+
+		const FFileStatData Stat = IFileManager::Get().GetStatData(*FSaveGameContainer::GetFilePath(SaveName));
+		FSaveGameContainerReader Reader;
+		FEntry Entry;
+
+		if (Stat.bIsValid)
+		{
+			// Only read the summary of slots that have changed since they were indexed
+			const FEntry* PreviousEntry = PreviousEntries.Find(SaveName);
+
+			if (PreviousEntry && PreviousEntry->FileSize == Stat.FileSize
+				&& PreviousEntry->FileTimestamp == Stat.ModificationTime)
+			{
+				Entry = *PreviousEntry;
+			}
+			else if (Reader.OpenSummary(FSaveGameContainer::GetFilePath(SaveName)))
+			{
+				Entry.FileSize = Stat.FileSize;
+				Entry.FileTimestamp = Stat.ModificationTime;
+				Entry.Summary = Reader.GetSummary();
+				bChanged = true;
+			}
+			else
+			{
+				continue;
+			}
+
+			Entries.Add(SaveName, Entry);
+		}
+		else if (const FEntry* PreviousEntry = PreviousUnindexedEntries.Find(SaveName))
+		{
+			Entry = *PreviousEntry;
+			UnindexedEntries.Add(SaveName, Entry);
+		}
+		else
+		{
+			// Not a file we can read part of, so the whole container has to be loaded (once, until it's written again)
+			TArray<uint8> ContainerData;
+			if (!SaveSystem->LoadGame(false, *SaveName, UserIndex, ContainerData))
+			{
+				continue;
+			}
+
+			Entry.FileSize = ContainerData.Num();
+
+			if (!Reader.Open(MoveTemp(ContainerData)))
+			{
+				continue;
+			}
+
+			Entry.Summary = Reader.GetSummary();
+			UnindexedEntries.Add(SaveName, Entry);
+		}
+
+		FSaveGameSlotInfo& Slot = OutSlots.AddDefaulted_GetRef();
+		Slot.SaveName = SaveName;
+		Slot.Size = Entry.FileSize;
+		Slot.bHasSummary = Entry.Summary.IsSet();
+
+		if (Entry.Summary.IsSet())
+		{
+			Slot.Timestamp = Entry.Summary->Timestamp;
+			Slot.LastVisitedMap = Entry.Summary->LastVisitedMap;
+			Slot.PlayTime = FTimespan::FromSeconds(Entry.Summary->PlayTime);
+		}
+	}
+
+	// Slots that have been deleted also change the index
+	if (bChanged || Entries.Num() != PreviousEntries.Num())
+	{
+		SaveIndex();
+	}
+
+	// Most recent first, as a load menu would show them
+	OutSlots.Sort([](const FSaveGameSlotInfo& A, const FSaveGameSlotInfo& B)
+	{
+		return A.Timestamp > B.Timestamp;
+	});
+}
+
+void FSaveGameSlotIndex::InvalidateSlot(const FString& SaveName)
+{
+	FScopeLock ScopeLock(&Lock);
+	UnindexedEntries.Remove(SaveName);
+}
+
+FString FSaveGameSlotIndex::GetIndexFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("SaveGames") / TEXT("SaveGameSlots.idx");
+}
+
+void FSaveGameSlotIndex::LoadIndex()
+{
+	if (bLoaded)
+	{
+		return;
+	}
+
+	bLoaded = true;
+
+	TArray<uint8> IndexData;
+	if (!FFileHelper::LoadFileToArray(IndexData, *GetIndexFilePath(), FILEREAD_Silent))
+	{
+		return;
+	}
+
+	FMemoryReader Reader(IndexData);
+
+	uint32 Tag = 0;
+	int32 Version = 0;
+	Reader << Tag << Version;
+
+	// The summaries are stored as the container stores them, so an index of another version is rebuilt
+	if (Tag != SlotIndexTag || Version != FSaveGameContainer::LatestVersion)
+	{
+		return;
+	}
+
+	Reader << Entries;
+
+	if (Reader.IsError())
+	{
+		UE_LOG(LogSaveGameSlotIndex, Warning, TEXT("Save game slot index is corrupt, it will be rebuilt"));
+		Entries.Reset();
+	}
+}
+
+void FSaveGameSlotIndex::SaveIndex()
+{
+	TArray<uint8> IndexData;
+	FMemoryWriter Writer(IndexData);
+
+	uint32 Tag = SlotIndexTag;
+	int32 Version = FSaveGameContainer::LatestVersion;
+	Writer << Tag << Version;
+	Writer << Entries;
+
+	if (!FFileHelper::SaveArrayToFile(IndexData, *GetIndexFilePath()))
+	{
+		UE_LOG(LogSaveGameSlotIndex, Warning, TEXT("Couldn't write save game slot index to %s"), *GetIndexFilePath());
+	}
+}
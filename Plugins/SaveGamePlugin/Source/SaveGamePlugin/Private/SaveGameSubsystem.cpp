@@ -7,10 +7,17 @@
 #include "SaveGameSerializer.h"
 
 #include "EngineUtils.h"
+#include "Algo/AnyOf.h"
+#include "PlatformFeatures.h"
 #include "SaveGameSettings.h"
+#include "Async/Async.h"
+#include "Misc/App.h"
+#include "ProfilingDebugging/CsvProfiler.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogSaveGameSubsystem, Log, All);
 
+CSV_DEFINE_CATEGORY(SaveGame, true);
+
 using namespace UE::Tasks;
 
 void USaveGameSubsystem::Initialize(FSubsystemCollectionBase& Collection)
@@ -31,7 +38,11 @@ void USaveGameSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	/** Start the auto timer if autosaving is enabled */
 	if (SaveGameSettings->bEnableAutoSaveTimer)
 	{
-		// TODO:  AutoSave();
+		AutosaveTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &ThisClass::TickAutosave));
+
+		// Found well before the first autosave, so that the ticker doesn't have to wait on the slots being read
+		FindNextAutosaveSlot();
 	}
 }
 
@@ -43,6 +54,10 @@ void USaveGameSubsystem::Deinitialize()
 
 	FWorldDelegates::LevelAddedToWorld.RemoveAll(this);
 	FWorldDelegates::PreLevelRemovedFromWorld.RemoveAll(this);
+
+	FTSTicker::GetCoreTicker().RemoveTicker(AutosaveTickerHandle);
+
+	JsonOutputPipe.WaitUntilEmpty();
 }
 
 void USaveGameSubsystem::Save(FString SaveName)
@@ -53,18 +68,38 @@ void USaveGameSubsystem::Save(FString SaveName)
 
 	OnSaveStart.Broadcast(); // Notify save start
 
+	// Any save puts off the next autosave
+	AutosaveElapsed = 0.0f;
+
+	const bool bAutosave = SaveGameSettings->IsAutosaveSlot(SaveName);
+	const double StartTime = FPlatformTime::Seconds();
+
 	TSharedPtr<TSaveGameSerializer<false>> Serializer = MakeShared<TSaveGameSerializer<false>>(this, SaveName);
-	SaveGamePipe.Launch(UE_SOURCE_LOCATION, [this, Serializer]
+	SaveGamePipe.Launch(UE_SOURCE_LOCATION, [this, Serializer, bAutosave, StartTime]
 	{
 		FTask Previous = Serializer->DoOperation();
 
-		AddNested(Launch(UE_SOURCE_LOCATION, [this, Serializer]() mutable
+		AddNested(Launch(UE_SOURCE_LOCATION, [this, Serializer, bAutosave, StartTime]() mutable
 		{
-			Serializer.Reset();
+			if (bAutosave)
+			{
+				ReportAutosave(FPlatformTime::Seconds() - StartTime, Serializer->GetGameThreadSeconds(),
+				               Serializer->GetMaxGameThreadFrameSeconds());
+			}
+
 			TRACE_END_REGION(RegionName);
 			UE_LOG(LogSaveGameSubsystem, Log, TEXT("%s: End"), RegionName);
 
 			OnSaveDone.Broadcast(); // Notify save completion
+
+			// The save may still be being written, which whatever is next in our pipe has to wait for
+			const TTask<bool> WriteTask = Serializer->GetWriteTask();
+			AddNested(Launch(UE_SOURCE_LOCATION, [this, Serializer = MoveTemp(Serializer), WriteTask]() mutable
+			{
+				SlotIndex->InvalidateSlot(Serializer->GetSaveName());
+				Serializer.Reset();
+				OnSaveWritten.Broadcast(WriteTask.GetResult());
+			}, WriteTask));
 		}, Previous));
 	});
 }
@@ -76,6 +111,7 @@ void USaveGameSubsystem::Load(FString SaveName)
 	TRACE_BEGIN_REGION(RegionName);
 
 	OnLoadStart.Broadcast();
+	AutosaveElapsed = 0.0f;
 
 	TSharedPtr<TSaveGameSerializer<true>> Serializer = MakeShared<TSaveGameSerializer<true>>(this, SaveName);
 
@@ -85,15 +121,142 @@ void USaveGameSubsystem::Load(FString SaveName)
 		FTask Previous = Serializer->DoOperation();
 		AddNested(Launch(UE_SOURCE_LOCATION, [this, Serializer]() mutable
 		{
+			const bool bSucceeded = !Serializer->HasLoadFailed();
 			Serializer.Reset();
 			TRACE_END_REGION(RegionName);
 			UE_LOG(LogSaveGameSubsystem, Log, TEXT("%s: End"), RegionName);
 
-			OnLoadDone.Broadcast();
+			OnLoadDone.Broadcast(bSucceeded);
 		}, Previous));
 	});
 }
 
+void USaveGameSubsystem::Autosave()
+{
+	const int32 NumSlots = FMath::Max(SaveGameSettings->NumAutosaveSlots, 1);
+
+	if (NextAutosaveSlot == INDEX_NONE)
+	{
+		// Only waits if the autosave timer isn't enabled, or this is called straight away
+		NextAutosaveSlot = FindNextAutosaveSlot().GetResult();
+	}
+
+	const int32 SlotIdx = NextAutosaveSlot % NumSlots;
+	NextAutosaveSlot = (SlotIdx + 1) % NumSlots;
+
+	Save(SaveGameSettings->GetAutosaveSlotName(SlotIdx));
+}
+
+TTask<int32> USaveGameSubsystem::FindNextAutosaveSlot()
+{
+	if (NextAutosaveSlotTask.IsValid())
+	{
+		return NextAutosaveSlotTask;
+	}
+
+	const TTask<TArray<FSaveGameSlotInfo>> ListTask = GetSaveSlotsAsync();
+
+	NextAutosaveSlotTask = Launch(UE_SOURCE_LOCATION, [ListTask, Settings = SaveGameSettings]
+	{
+		const int32 NumSlots = FMath::Max(Settings->NumAutosaveSlots, 1);
+
+		// Slots are sorted from most recent, and only their summaries are read
+		for (const FSaveGameSlotInfo& Slot : ListTask.GetResult())
+		{
+			for (int32 SlotIdx = 0; SlotIdx < NumSlots; ++SlotIdx)
+			{
+				if (Slot.SaveName == Settings->GetAutosaveSlotName(SlotIdx))
+				{
+					return (SlotIdx + 1) % NumSlots;
+				}
+			}
+		}
+
+		return 0;
+	}, ListTask);
+
+	return NextAutosaveSlotTask;
+}
+
+bool USaveGameSubsystem::TickAutosave(float DeltaTime)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_TickAutosave);
+
+	const UWorld* World = GetWorld();
+
+	if (!IsValid(World) || !World->IsGameWorld() || World->IsPaused())
+	{
+		return true;
+	}
+
+	AutosaveElapsed += DeltaTime;
+
+	const float Interval = SaveGameSettings->AutoSaveInterval;
+	if (Interval <= 0.0f || AutosaveElapsed < Interval)
+	{
+		return true;
+	}
+
+	// Saves and loads would queue up behind each other, so an autosave would only repeat what's being saved
+	if (SaveGamePipe.HasWork() || World->IsInSeamlessTravel())
+	{
+		return true;
+	}
+
+	// Rather than reading the slots here, wait for them to have been read
+	if (NextAutosaveSlot == INDEX_NONE && !FindNextAutosaveSlot().IsCompleted())
+	{
+		return true;
+	}
+
+	const float QuietFrameTimeMs = SaveGameSettings->AutoSaveQuietFrameTimeMs;
+	const bool bQuietFrame = QuietFrameTimeMs <= 0.0f || FApp::GetDeltaTime() * 1000.0 <= QuietFrameTimeMs;
+	const bool bStreaming = IsAsyncLoading() || World->IsVisibilityRequestPending();
+	const float Delay = AutosaveElapsed - Interval;
+
+	if ((!bQuietFrame || bStreaming) && Delay < SaveGameSettings->AutoSaveMaxDelay)
+	{
+		return true;
+	}
+
+	if (Delay > 0.0f)
+	{
+		UE_LOG(LogSaveGameSubsystem, Verbose, TEXT("Autosave was put off for %.1fs (quiet frame: %i, streaming: %i)"),
+		       Delay, bQuietFrame, bStreaming);
+	}
+
+	Autosave();
+	return true;
+}
+
+void USaveGameSubsystem::ReportAutosave(double DurationSeconds, double GameThreadSeconds, double HitchSeconds)
+{
+	const float DurationMs = DurationSeconds * 1000.0;
+	const float GameThreadMs = GameThreadSeconds * 1000.0;
+	const float HitchMs = HitchSeconds * 1000.0;
+
+	UE_LOG(LogSaveGameSubsystem, Log,
+	       TEXT("Autosave took %.1fms, %.2fms of it on the game thread (%.2fms at most in a frame)"),
+	       DurationMs, GameThreadMs, HitchMs);
+
+	CSV_CUSTOM_STAT(SaveGame, AutosaveDurationMs, DurationMs, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(SaveGame, AutosaveGameThreadMs, GameThreadMs, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(SaveGame, AutosaveHitchMs, HitchMs, ECsvCustomStatOp::Set);
+
+	AsyncTask(ENamedThreads::GameThread, [WeakThis = TWeakObjectPtr<ThisClass>(this), DurationMs, GameThreadMs, HitchMs]
+	{
+		if (ThisClass* This = WeakThis.Get())
+		{
+			FSaveGameAutosaveStats& Stats = This->AutosaveStats;
+			++Stats.NumAutosaves;
+			Stats.LastDurationMs = DurationMs;
+			Stats.LastGameThreadMs = GameThreadMs;
+			Stats.LastHitchMs = HitchMs;
+			Stats.MaxHitchMs = FMath::Max(Stats.MaxHitchMs, HitchMs);
+		}
+	});
+}
+
 void USaveGameSubsystem::OnPreWorldDestroyed(UWorld* World)
 {
 	if (!IsValid(World) || GetWorld() != World)
@@ -102,6 +265,10 @@ void USaveGameSubsystem::OnPreWorldDestroyed(UWorld* World)
 	}
 	SaveGameActors.Reset();
 	DestroyedLevelActors.Reset();
+	DirtyActors.Reset();
+	ActorCache.Reset();
+	PendingLevels.Reset();
+	SaveNameTable = MakeShared<FSaveGameNameTable>();
 }
 
 void USaveGameSubsystem::OnLevelAddedToWorld(ULevel* Level, UWorld* World)
@@ -115,13 +282,65 @@ void USaveGameSubsystem::OnLevelAddedToWorld(ULevel* Level, UWorld* World)
 		return;
 	}
 
-	/** We should check the archive in memory and update the actors part of the level thats being added with the loaded save data */
-
-	/** Then we check the level for actors we want to save for later reference */
+	/** We check the level for actors we want to save for later reference */
 	for (AActor* Actor : Level->Actors)
 	{
 		OnActorPreSpawn(Actor);
 	}
+
+	const FTopLevelAssetPath LevelAssetPath(Level->GetPackage()->GetFName(), Level->GetOuter()->GetFName());
+
+	/**
+	 * Level actors that were destroyed stay destroyed, whether that was before the level was streamed out or in the
+	 * last loaded save. Levels only have a pending level if they also have saved actors, so this can't be left to it
+	 */
+	TArray<AActor*> ActorsToDestroy;
+	for (const FSoftObjectPath& DestroyedActor : DestroyedLevelActors)
+	{
+		if (DestroyedActor.GetAssetPath() == LevelAssetPath)
+		{
+			AActor* Actor = Cast<AActor>(DestroyedActor.ResolveObject());
+			if (IsValid(Actor) && Actor->GetLevel() == Level)
+			{
+				ActorsToDestroy.Add(Actor);
+			}
+		}
+	}
+
+	// Destroying them adds them to DestroyedLevelActors again, so they can't be destroyed while it's iterated
+	for (AActor* Actor : ActorsToDestroy)
+	{
+		Actor->Destroy();
+	}
+
+	/** Then apply what the last loaded save had for the actors of this level, if it was left pending */
+	FSaveGamePendingLevel PendingLevel;
+	if (PendingLevels.RemoveAndCopyValue(LevelAssetPath, PendingLevel))
+	{
+		LoadPendingLevel(MoveTemp(PendingLevel));
+	}
+}
+
+void USaveGameSubsystem::LoadPendingLevel(FSaveGamePendingLevel&& PendingLevel)
+{
+	constexpr TCHAR RegionName[] = TEXT("SaveGame[LoadLevel]");
+	TRACE_BEGIN_REGION(RegionName);
+
+	TSharedPtr<TSaveGameSerializer<true>> Serializer = MakeShared<TSaveGameSerializer<true>>(
+		this, PendingLevel.Context->SaveName);
+	Serializer->SetPendingLevel(MoveTemp(PendingLevel));
+
+	// Queued behind any save or load, which may be the one that left this level pending
+	SaveGamePipe.Launch(UE_SOURCE_LOCATION, [Serializer]
+	{
+		FTask Previous = Serializer->DoOperation();
+
+		AddNested(Launch(UE_SOURCE_LOCATION, [Serializer]() mutable
+		{
+			Serializer.Reset();
+			TRACE_END_REGION(RegionName);
+		}, Previous));
+	});
 }
 
 void USaveGameSubsystem::OnPreLevelRemovedFromWorld(ULevel* Level, UWorld* World)
@@ -135,6 +354,26 @@ void USaveGameSubsystem::OnPreLevelRemovedFromWorld(ULevel* Level, UWorld* World
 		return;
 	}
 
+	const bool bHasSaveGameActors = Algo::AnyOf(Level->Actors, [this](AActor* Actor)
+	{
+		return IsValid(Actor) && SaveGameActors.Contains(Actor);
+	});
+
+	if (bHasSaveGameActors && !World->bIsTearingDown && !World->IsInSeamlessTravel())
+	{
+		constexpr TCHAR RegionName[] = TEXT("SaveGame[SnapshotLevel]");
+		TRACE_BEGIN_REGION(RegionName);
+
+		// Otherwise our actors would be as they were loaded when the level is streamed back in, and left out of saves
+		// meanwhile. Not when the whole world is going, as its pending levels go with it
+		const FTopLevelAssetPath LevelAssetPath(Level->GetPackage()->GetFName(), Level->GetOuter()->GetFName());
+		const TSharedRef<TSaveGameSerializer<false>> Serializer = MakeShared<TSaveGameSerializer<false>>(
+			this, LevelAssetPath.ToString(), Level);
+		PendingLevels.Add(LevelAssetPath, Serializer->SnapshotLevel());
+
+		TRACE_END_REGION(RegionName);
+	}
+
 	for (AActor* Actor : Level->Actors)
 	{
 		if (IsValid(Actor))
@@ -149,6 +388,58 @@ bool USaveGameSubsystem::IsLoadingSaveGame() const
 	return SaveGamePipe.HasWork();
 }
 
+TArray<FSaveGameSlotInfo> USaveGameSubsystem::GetSaveSlots()
+{
+	TArray<FSaveGameSlotInfo> Slots;
+	SlotIndex->GetSlots(IPlatformFeaturesModule::Get().GetSaveGameSystem(), 0, Slots);
+	return Slots;
+}
+
+void USaveGameSubsystem::ListSaveSlots(FSaveSlotsListed OnListed)
+{
+	const TTask<TArray<FSaveGameSlotInfo>> ListTask = GetSaveSlotsAsync();
+
+	Launch(UE_SOURCE_LOCATION, [ListTask, OnListed = MoveTemp(OnListed)]
+	{
+		AsyncTask(ENamedThreads::GameThread, [Slots = ListTask.GetResult(), OnListed]
+		{
+			OnListed.ExecuteIfBound(Slots);
+		});
+	}, ListTask);
+}
+
+TTask<TArray<FSaveGameSlotInfo>> USaveGameSubsystem::GetSaveSlotsAsync()
+{
+	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+
+	return Launch(UE_SOURCE_LOCATION, [SlotIndex = SlotIndex, SaveSystem]
+	{
+		TArray<FSaveGameSlotInfo> Slots;
+		SlotIndex->GetSlots(SaveSystem, 0, Slots);
+		return Slots;
+	});
+}
+
+double USaveGameSubsystem::GetPlayTime() const
+{
+	const UWorld* World = GetWorld();
+	return PlayTimeOffset + (World ? World->GetUnpausedTimeSeconds() : 0.0);
+}
+
+void USaveGameSubsystem::SetPlayTime(double PlayTime)
+{
+	const UWorld* World = GetWorld();
+	PlayTimeOffset = PlayTime - (World ? World->GetUnpausedTimeSeconds() : 0.0);
+}
+
+void USaveGameSubsystem::MarkActorDirty(AActor* Actor)
+{
+	if (IsValid(Actor))
+	{
+		DirtyActors.Add(Actor);
+	}
+}
+
 void USaveGameSubsystem::OnWorldInitialized(UWorld* World, const UWorld::InitializationValues)
 {
 	if (!IsValid(World) || GetWorld() != World)
@@ -191,6 +482,15 @@ void USaveGameSubsystem::OnWorldCleanup(UWorld* World, bool, bool)
 
 	SaveGameActors.Reset();
 	DestroyedLevelActors.Reset();
+	DirtyActors.Reset();
+	ActorCache.Reset();
+	PendingLevels.Reset();
+
+	// Nothing references the name table anymore, a save that's still running keeps the one that it started with
+	SaveNameTable = MakeShared<FSaveGameNameTable>();
+
+	// The next world's time starts from zero
+	PlayTimeOffset += World->GetUnpausedTimeSeconds();
 }
 
 void USaveGameSubsystem::OnActorPreSpawn(AActor* Actor)
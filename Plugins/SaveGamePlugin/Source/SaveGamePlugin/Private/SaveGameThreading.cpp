@@ -2,6 +2,8 @@
 
 #include "SaveGameThreading.h"
 
+#include "SaveGameTransform.h"
+
 class FSaveGameThreadQueue final : public ISaveGameThreadQueue
 {
 public:
@@ -21,18 +23,60 @@ public:
 
 	virtual void AddTask(TFunction<void()>&& Task) override
 	{
-		WorkQueue.Push(new FTaskFunction(Task));
+		{
+			FScopeLock ScopeLock(&BatchLock);
+
+			// Transforms queued after this task have to be set after it
+			OpenBatch.Reset();
+			WorkQueue.Push(new FTaskFunction(MoveTemp(Task)));
+		}
+
 		Event->Trigger();
 	}
 
-	bool ProcessThread(int64 WaitCycles)
+	virtual void AddTransform(AActor* Actor, const FTransform& Transform) override
+	{
+		FScopeLock ScopeLock(&BatchLock);
+
+		if (!OpenBatch.IsValid())
+		{
+			// The batch takes this transform's place in the queue, and the places of those that follow it
+			OpenBatch = MakeShared<FSaveGameTransformBatch>();
+			WorkQueue.Push(new FTaskFunction([this, Batch = OpenBatch.ToSharedRef()]
+			{
+				{
+					// Nothing can be added to the batch once it's being applied
+					FScopeLock ApplyScopeLock(&BatchLock);
+					if (OpenBatch == Batch)
+					{
+						OpenBatch.Reset();
+					}
+				}
+
+				Batch->Apply();
+			}));
+
+			Event->Trigger();
+		}
+
+		OpenBatch->Add(Actor, Transform);
+	}
+
+	void ProcessUntil(const UE::Tasks::FTask& Task)
 	{
 		check(ThreadId == FPlatformTLS::GetCurrentThreadId());
-		bool bDidWork = false;
-		bool bTriggered;
 
-		do
+		// Wake us up once the task has completed, we wait on this instead of the task, as it's the last to touch us
+		const UE::Tasks::FTask WakeTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this]
+		{
+			Event->Trigger();
+		}, Task, UE::Tasks::ETaskPriority::Default, UE::Tasks::EExtendedTaskPriority::Inline);
+
+		while (true)
 		{
+			// Reset before processing, so that anything queued afterwards will still wake us up
+			Event->Reset();
+
 			{
 				QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_ProcessThreadQueue);
 
@@ -40,16 +84,17 @@ public:
 				{
 					(*Function)();
 					delete Function;
-					bDidWork = true;
 				}
 			}
 
-			QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_WaitThreadQueue);
-			Event->Reset();
-			bTriggered = Event->Wait(FTimespan(WaitCycles));
-		} while (bTriggered || !IsComplete());
+			if (WakeTask.IsCompleted() && IsComplete())
+			{
+				break;
+			}
 
-		return bDidWork;
+			QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_WaitThreadQueue);
+			Event->Wait();
+		}
 	}
 
 	bool IsComplete() const { return WorkQueue.IsEmpty(); }
@@ -58,6 +103,10 @@ private:
 	const uint32 ThreadId;
 	TLockFreePointerListFIFO<FTaskFunction, PLATFORM_CACHE_LINE_SIZE> WorkQueue;
 	FEvent* Event;
+
+	/** The batch at the end of the queue, which transforms are added to until a task is queued after it */
+	FCriticalSection BatchLock;
+	TSharedPtr<FSaveGameTransformBatch> OpenBatch;
 };
 
 static TSharedPtr<FSaveGameThreadQueue> GSaveGameThreadQueue;
@@ -80,7 +129,7 @@ FSaveGameTheadScope::~FSaveGameTheadScope()
 	GSaveGameThreadQueue.Reset();
 }
 
-bool FSaveGameTheadScope::ProcessThread(int64 WaitCycles) const
+void FSaveGameTheadScope::ProcessUntil(const UE::Tasks::FTask& Task) const
 {
-	return GSaveGameThreadQueue->ProcessThread(WaitCycles);
+	GSaveGameThreadQueue->ProcessUntil(Task);
 }
@@ -0,0 +1,105 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "SaveGameTrainDictionaryCommandlet.h"
+
+#include "PlatformFeatures.h"
+#include "SaveGameCompression.h"
+#include "SaveGameContainer.h"
+#include "SaveGameSettings.h"
+#include "SaveGameSystem.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSaveGameTrainDictionary, Log, All);
+
+USaveGameTrainDictionaryCommandlet::USaveGameTrainDictionaryCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 USaveGameTrainDictionaryCommandlet::Main(const FString& Params)
+{
+	FString OutputPath = GetDefault<USaveGameSettings>()->CompressionDictionary;
+	int32 DictionarySize = FSaveGameCompressionDictionary::MaxSize;
+	int32 UserIndex = 0;
+
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	FParse::Value(*Params, TEXT("Size="), DictionarySize);
+	FParse::Value(*Params, TEXT("User="), UserIndex);
+
+	if (OutputPath.IsEmpty())
+	{
+		UE_LOG(LogSaveGameTrainDictionary, Error, TEXT("No output path, set a CompressionDictionary or pass -Output="));
+		return 1;
+	}
+
+	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	TArray<FString> SaveNames;
+
+	if (!SaveSystem || !SaveSystem->GetSaveGameNames(SaveNames, UserIndex))
+	{
+		UE_LOG(LogSaveGameTrainDictionary, Error, TEXT("Couldn't find any save games to train on"));
+		return 1;
+	}
+
+	// Keep each level's data around, as the samples reference it
+	TArray<TArray<uint8>> SaveData;
+	TArray<TConstArrayView<uint8>> Samples;
+
+	for (const FString& SaveName : SaveNames)
+	{
+		TArray<uint8> ContainerData;
+		FSaveGameContainerReader Reader;
+
+		if (SaveName.EndsWith(TEXT(".json")) || !SaveSystem->LoadGame(false, *SaveName, UserIndex, ContainerData)
+			|| !Reader.Open(MoveTemp(ContainerData)))
+		{
+			UE_LOG(LogSaveGameTrainDictionary, Display, TEXT("Skipping %s, as it isn't a save game container"), *SaveName);
+			continue;
+		}
+
+		// Each actor is compressed on its own, so they make up our samples
+		for (const FSaveGameTableOfContents::FLevelSection& Level : Reader.GetTableOfContents().Levels)
+		{
+			TArray<uint8> Data;
+			if (!Reader.ReadSection(Level, Data))
+			{
+				UE_LOG(LogSaveGameTrainDictionary, Warning, TEXT("Skipping %s in %s, as it couldn't be decompressed"),
+				       *Level.Name, *SaveName);
+				continue;
+			}
+
+			for (int32 ActorIdx = 0; ActorIdx < Level.ActorOffsets.Num(); ++ActorIdx)
+			{
+				const FSaveGameTableOfContents::FSection Actor = Level.GetActorSection(ActorIdx);
+				Samples.Add(MakeArrayView(Data.GetData() + (Actor.Offset - Level.Offset), IntCastChecked<int32>(Actor.Size)));
+			}
+
+			// Moving the array keeps its allocation, so our samples stay valid
+			SaveData.Add(MoveTemp(Data));
+		}
+	}
+
+	UE_LOG(LogSaveGameTrainDictionary, Display, TEXT("Training on %i actors from %i levels"),
+	       Samples.Num(), SaveData.Num());
+
+	const TArray<uint8> Dictionary = FSaveGameCompressionDictionary::Train(Samples, DictionarySize);
+
+	if (Dictionary.IsEmpty())
+	{
+		UE_LOG(LogSaveGameTrainDictionary, Error, TEXT("Not enough shared data to train a dictionary on"));
+		return 1;
+	}
+
+	if (!FFileHelper::SaveArrayToFile(Dictionary, *(FPaths::ProjectContentDir() / OutputPath)))
+	{
+		UE_LOG(LogSaveGameTrainDictionary, Error, TEXT("Couldn't write dictionary to %s"), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogSaveGameTrainDictionary, Display, TEXT("Wrote %i byte dictionary to %s"), Dictionary.Num(), *OutputPath);
+	return 0;
+}
@@ -0,0 +1,199 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "SaveGameTransform.h"
+
+#include "SaveGameSettings.h"
+#include "GameFramework/Actor.h"
+
+namespace SaveGameTransform
+{
+	enum EFlags : uint8
+	{
+		QuantizedLocation = 1 << 0,
+		UniformScale = 1 << 1,
+		UnitScale = 1 << 2,
+		FullPrecision = 1 << 3,
+	};
+
+	/** The three smallest components of a unit quaternion are within +/- 1/sqrt(2), which we spread over an int16 */
+	static constexpr double RotationScale = MAX_int16 * UE_DOUBLE_SQRT_2;
+}
+
+void FSaveGameTransform::Serialize(FStructuredArchive::FSlot Slot, FTransform& Transform)
+{
+	using namespace SaveGameTransform;
+
+	FStructuredArchive::FRecord Record = Slot.EnterRecord();
+	const bool bIsLoading = Record.GetUnderlyingArchive().IsLoading();
+
+	uint8 Flags = 0;
+	float Precision = 0.0f;
+	FIntVector GridLocation = FIntVector::ZeroValue;
+	FVector Location = FVector::ZeroVector;
+	FVector Scale = FVector::OneVector;
+
+	uint8 LargestComponent = 0;
+	int16 SmallestComponents[3] = {};
+
+	if (!bIsLoading && !GetDefault<USaveGameSettings>()->bQuantizeTransforms)
+	{
+		Flags |= FullPrecision;
+	}
+	else if (!bIsLoading)
+	{
+		Precision = GetDefault<USaveGameSettings>()->TransformPositionPrecision;
+		Location = Transform.GetLocation();
+		Scale = Transform.GetScale3D();
+
+		// Locations too far out to fit on the grid are stored as they are
+		const FVector Grid = Precision > 0.0f ? Location / Precision : FVector::ZeroVector;
+		if (Precision > 0.0f && Grid.GetAbsMax() < MAX_int32)
+		{
+			Flags |= QuantizedLocation;
+			GridLocation = FIntVector(FMath::RoundToInt32(Grid.X), FMath::RoundToInt32(Grid.Y), FMath::RoundToInt32(Grid.Z));
+		}
+
+		if (Scale == FVector::OneVector)
+		{
+			Flags |= UnitScale;
+		}
+		else if (Scale.AllComponentsEqual(0.0))
+		{
+			Flags |= UniformScale;
+		}
+
+		const FQuat Rotation = Transform.GetRotation().GetNormalized();
+		double Components[4] = {Rotation.X, Rotation.Y, Rotation.Z, Rotation.W};
+
+		for (uint8 ComponentIdx = 1; ComponentIdx < 4; ++ComponentIdx)
+		{
+			if (FMath::Abs(Components[ComponentIdx]) > FMath::Abs(Components[LargestComponent]))
+			{
+				LargestComponent = ComponentIdx;
+			}
+		}
+
+		// A quaternion and its negation are the same rotation, so flip it to make the largest positive, as it's the
+		// one that's rebuilt from the others
+		const double Sign = Components[LargestComponent] < 0.0 ? -1.0 : 1.0;
+
+		for (int32 ComponentIdx = 0, SmallestIdx = 0; ComponentIdx < 4; ++ComponentIdx)
+		{
+			if (ComponentIdx != LargestComponent)
+			{
+				const double Component = FMath::Clamp(Components[ComponentIdx] * Sign * RotationScale, MIN_int16, MAX_int16);
+				SmallestComponents[SmallestIdx++] = static_cast<int16>(FMath::RoundToInt32(Component));
+			}
+		}
+	}
+
+	Record << SA_VALUE(TEXT("Flags"), Flags);
+
+	if (Flags & FullPrecision)
+	{
+		Record << SA_VALUE(TEXT("Transform"), Transform);
+		return;
+	}
+
+	if (Flags & QuantizedLocation)
+	{
+		Record << SA_VALUE(TEXT("Precision"), Precision);
+
+		FStructuredArchive::FRecord LocationRecord = Record.EnterRecord(TEXT("Location"));
+		LocationRecord << SA_VALUE(TEXT("X"), GridLocation.X);
+		LocationRecord << SA_VALUE(TEXT("Y"), GridLocation.Y);
+		LocationRecord << SA_VALUE(TEXT("Z"), GridLocation.Z);
+	}
+	else
+	{
+		Record << SA_VALUE(TEXT("Location"), Location);
+	}
+
+	{
+		FStructuredArchive::FRecord RotationRecord = Record.EnterRecord(TEXT("Rotation"));
+		RotationRecord << SA_VALUE(TEXT("Largest"), LargestComponent);
+		RotationRecord << SA_VALUE(TEXT("A"), SmallestComponents[0]);
+		RotationRecord << SA_VALUE(TEXT("B"), SmallestComponents[1]);
+		RotationRecord << SA_VALUE(TEXT("C"), SmallestComponents[2]);
+
+		if (bIsLoading && LargestComponent > 3)
+		{
+			Record.GetUnderlyingArchive().SetError();
+			LargestComponent = 3;
+		}
+	}
+
+	// Scales are stored as floats, as they don't need the range of a location
+	if (Flags & UniformScale)
+	{
+		float UniformScale = Scale.X;
+		Record << SA_VALUE(TEXT("Scale"), UniformScale);
+		Scale = FVector(UniformScale);
+	}
+	else if (!(Flags & UnitScale))
+	{
+		FVector3f NonUniformScale(Scale);
+		Record << SA_VALUE(TEXT("Scale"), NonUniformScale);
+		Scale = FVector(NonUniformScale);
+	}
+
+	if (bIsLoading)
+	{
+		if (Flags & QuantizedLocation)
+		{
+			Location = FVector(GridLocation) * Precision;
+		}
+
+		double Components[4];
+		double SumOfSquares = 0.0;
+
+		for (int32 ComponentIdx = 0, SmallestIdx = 0; ComponentIdx < 4; ++ComponentIdx)
+		{
+			if (ComponentIdx != LargestComponent)
+			{
+				Components[ComponentIdx] = SmallestComponents[SmallestIdx++] / RotationScale;
+				SumOfSquares += FMath::Square(Components[ComponentIdx]);
+			}
+		}
+
+		Components[LargestComponent] = FMath::Sqrt(FMath::Max(0.0, 1.0 - SumOfSquares));
+
+		FQuat Rotation(Components[0], Components[1], Components[2], Components[3]);
+		Rotation.Normalize();
+
+		Transform = FTransform(Rotation, Location, Scale);
+	}
+}
+
+void FSaveGameTransformBatch::Add(AActor* Actor, const FTransform& Transform)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	Actors.Add(Actor);
+	Locations.Add(Transform.GetLocation());
+	Rotations.Add(Transform.GetRotation());
+	Scales.Add(Transform.GetScale3D());
+}
+
+void FSaveGameTransformBatch::Apply()
+{
+	check(IsInGameThread());
+
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SetActorTransforms);
+
+	FScopeLock ScopeLock(&Lock);
+
+	for (int32 TransformIdx = 0; TransformIdx < Actors.Num(); ++TransformIdx)
+	{
+		if (AActor* Actor = Actors[TransformIdx].Get())
+		{
+			const FTransform Transform(Rotations[TransformIdx], Locations[TransformIdx], Scales[TransformIdx]);
+			Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::TeleportPhysics);
+		}
+	}
+
+	Actors.Reset();
+	Locations.Reset();
+	Rotations.Reset();
+	Scales.Reset();
+}
@@ -0,0 +1,407 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "SaveGameContainer.h"
+
+#include "SaveGameCompression.h"
+#include "SaveGameSettings.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SaveGameContainerTests
+{
+	static constexpr int32 BlockSize = 16 * 1024;
+	static constexpr int32 NumActors = 64;
+
+	/** Data that compresses, but not down to nothing */
+	static TArray<uint8> MakeData(int32 Size, int32 Seed)
+	{
+		TArray<uint8> Data;
+		Data.SetNumUninitialized(Size);
+
+		for (int32 Idx = 0; Idx < Size; ++Idx)
+		{
+			Data[Idx] = static_cast<uint8>(Idx % 64 < 48 ? Idx / 64 + Seed : (Idx * 7 + Seed) % 251);
+		}
+
+		return Data;
+	}
+
+	/** A container, and the sections it was written with */
+	struct FTestContainer
+	{
+		TArray<uint8> Data;
+		FSaveGameTableOfContents Toc;
+		TArray<uint8> Header;
+		TArray<uint8> Level;
+		TArray<uint8> Versions;
+		TArray<uint8> Names;
+
+		/** All of the sections, in the order they were written */
+		TArray<uint8> GetUncompressedData() const
+		{
+			TArray<uint8> Uncompressed = Header;
+			Uncompressed.Append(Level);
+			Uncompressed.Append(Versions);
+			Uncompressed.Append(Names);
+			return Uncompressed;
+		}
+	};
+
+	/**
+	 * Writes a container the way the serializer does: a header, then a level of actors that spans several blocks (with
+	 * each actor starting a block of its own when using a dictionary), then the versions and names.
+	 */
+	static void WriteContainer(FTestContainer& OutContainer, const FSaveGameCompressionDictionary* Dictionary)
+	{
+		OutContainer.Header = MakeData(100, 1);
+		OutContainer.Versions = MakeData(40, 2);
+		OutContainer.Names = MakeData(300, 3);
+
+		FSaveGameSummary Summary;
+		Summary.Timestamp = FDateTime(2024, 1, 2, 3, 4, 5);
+		Summary.LastVisitedMap = TEXT("/Game/Maps/TestMap");
+		Summary.PlayTime = 1234.5;
+		Summary.EngineVersion = FEngineVersion::Current();
+
+		FMemoryWriter Writer(OutContainer.Data);
+		FSaveGameContainerWriter ContainerWriter(Writer, Summary, NAME_Zlib, ESaveGameCompressionLevel::Normal,
+		                                         BlockSize, Dictionary);
+
+		uint64 Offset = 0;
+		auto WriteSection = [&ContainerWriter, &Offset](const TArray<uint8>& Data,
+		                                                FSaveGameTableOfContents::FSection& OutSection)
+		{
+			OutSection.Offset = Offset;
+			OutSection.Size = Data.Num();
+			Offset += Data.Num();
+
+			ContainerWriter.Write(FSharedBuffer::Clone(Data.GetData(), Data.Num()));
+		};
+
+		WriteSection(OutContainer.Header, OutContainer.Toc.Header);
+
+		FSaveGameTableOfContents::FLevelSection& LevelSection = OutContainer.Toc.Levels.AddDefaulted_GetRef();
+		LevelSection.Name = TEXT("/Game/Maps/TestMap.TestMap");
+		LevelSection.Offset = Offset;
+
+		for (int32 ActorIdx = 0; ActorIdx < NumActors; ++ActorIdx)
+		{
+			if (ContainerWriter.UsesDictionary())
+			{
+				ContainerWriter.Flush();
+			}
+
+			const TArray<uint8> Actor = MakeData(1000 + ActorIdx * 20, ActorIdx);
+			LevelSection.ActorOffsets.Add(OutContainer.Level.Num());
+			OutContainer.Level.Append(Actor);
+
+			ContainerWriter.Write(FSharedBuffer::Clone(Actor.GetData(), Actor.Num()));
+		}
+
+		LevelSection.Size = OutContainer.Level.Num();
+		Offset += OutContainer.Level.Num();
+
+		WriteSection(OutContainer.Versions, OutContainer.Toc.Versions);
+		WriteSection(OutContainer.Names, OutContainer.Toc.Names);
+
+		ContainerWriter.Finalize(OutContainer.Toc);
+	}
+
+	/** Reads back each section of the container, and each of its actors (from last to first) */
+	static void TestSections(FAutomationTestBase& Test, FSaveGameContainerReader& Reader,
+	                         const FTestContainer& Container)
+	{
+		const FSaveGameTableOfContents& Toc = Reader.GetTableOfContents();
+
+		if (Test.TestTrue(TEXT("Container has a summary"), Reader.GetSummary().IsSet()))
+		{
+			Test.TestEqual(TEXT("Summary map"), Reader.GetSummary()->LastVisitedMap, TEXT("/Game/Maps/TestMap"));
+			Test.TestEqual(TEXT("Summary play time"), Reader.GetSummary()->PlayTime, 1234.5);
+		}
+
+		Test.TestTrue(TEXT("Level spans several blocks"), Toc.Blocks.Num() > 2);
+
+		if (!Test.TestEqual(TEXT("Number of levels"), Toc.Levels.Num(), 1))
+		{
+			return;
+		}
+
+		TArray<uint8> Data;
+		Test.TestTrue(TEXT("Header reads back"), Reader.ReadSection(Toc.Header, Data) && Data == Container.Header);
+		Test.TestTrue(TEXT("Level reads back"), Reader.ReadSection(Toc.Levels[0], Data) && Data == Container.Level);
+
+		const FSaveGameTableOfContents::FLevelSection& LevelSection = Toc.Levels[0];
+		if (Test.TestEqual(TEXT("Number of actors"), LevelSection.ActorOffsets.Num(), NumActors))
+		{
+			// Out of order, as a level's actors are read when it's streamed in
+			for (int32 ActorIdx = NumActors - 1; ActorIdx >= 0; --ActorIdx)
+			{
+				const FSaveGameTableOfContents::FSection ActorSection = LevelSection.GetActorSection(ActorIdx);
+				const TArray<uint8> Actor = MakeData(1000 + ActorIdx * 20, ActorIdx);
+
+				if (!Reader.ReadSection(ActorSection, Data) || Data != Actor)
+				{
+					Test.AddError(FString::Printf(TEXT("Actor %i doesn't read back"), ActorIdx));
+				}
+			}
+		}
+
+		Test.TestTrue(TEXT("Versions read back"), Reader.ReadSection(Toc.Versions, Data) && Data == Container.Versions);
+		Test.TestTrue(TEXT("Names read back"), Reader.ReadSection(Toc.Names, Data) && Data == Container.Names);
+	}
+
+	/** The offset of the container's table of contents, which follows its tag and version */
+	static int64 GetTableOfContentsOffset(const TArray<uint8>& Data)
+	{
+		FMemoryReader Reader(Data);
+		Reader.Seek(sizeof(uint32) + sizeof(int32));
+
+		int64 TocOffset = 0;
+		Reader << TocOffset;
+		return TocOffset;
+	}
+
+	/** Copies the container with its table of contents replaced */
+	static TArray<uint8> ReplaceTableOfContents(const TArray<uint8>& Data, FSaveGameTableOfContents Toc)
+	{
+		TArray<uint8> Replaced(Data.GetData(), static_cast<int32>(GetTableOfContentsOffset(Data)));
+
+		FMemoryWriter Writer(Replaced, false, true);
+		Toc.Serialize(Writer, FSaveGameContainer::LatestVersion);
+
+		return Replaced;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSaveGameContainerRoundTripTest, "SaveGamePlugin.Container.RoundTrip",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSaveGameContainerRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace SaveGameContainerTests;
+
+	FTestContainer Container;
+	WriteContainer(Container, nullptr);
+
+	{
+		FSaveGameContainerReader Reader;
+		if (TestTrue(TEXT("Opens from memory"), Reader.Open(TArray<uint8>(Container.Data))))
+		{
+			TestSections(*this, Reader, Container);
+		}
+	}
+
+	// Streamed from the file, as the generic save game system's saves are
+	const FString FilePath = FPaths::AutomationTransientDir() / TEXT("SaveGameContainerRoundTrip.sav");
+
+	if (TestTrue(TEXT("Container file is written"), FFileHelper::SaveArrayToFile(Container.Data, *FilePath)))
+	{
+		{
+			FSaveGameContainerReader Reader;
+			if (TestTrue(TEXT("Opens from file"), Reader.Open(FilePath)))
+			{
+				TestSections(*this, Reader, Container);
+			}
+		}
+
+		FSaveGameContainerReader SummaryReader;
+		TestTrue(TEXT("Opens summary from file"), SummaryReader.OpenSummary(FilePath) && SummaryReader.GetSummary());
+
+		IFileManager::Get().Delete(*FilePath);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSaveGameContainerDictionaryTest, "SaveGamePlugin.Container.Dictionary",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSaveGameContainerDictionaryTest::RunTest(const FString& Parameters)
+{
+	using namespace SaveGameContainerTests;
+
+	const FSaveGameCompressionDictionary Dictionary(MakeData(4096, 5));
+
+	// A single actor's block, which is what dictionaries are for
+	const TArray<uint8> Block = MakeData(1200, 5);
+	TArray<uint8> Compressed;
+	FSaveGameCompression::CompressBlock(Block, NAME_Zlib, ESaveGameCompressionLevel::Normal, Compressed, &Dictionary);
+
+	TArray<uint8> Decompressed;
+	Decompressed.SetNumUninitialized(Block.Num());
+	TestTrue(TEXT("Block decompresses with its dictionary"),
+	         FSaveGameCompression::DecompressBlock(Compressed, NAME_Zlib, Decompressed, &Dictionary)
+	         && Decompressed == Block);
+
+	// Blocks that didn't compress are stored as they are, and don't need it
+	if (Compressed.Num() < Block.Num())
+	{
+		TestFalse(TEXT("Block doesn't decompress without its dictionary"),
+		          FSaveGameCompression::DecompressBlock(Compressed, NAME_Zlib, Decompressed));
+	}
+
+	FTestContainer Container;
+	WriteContainer(Container, &Dictionary);
+
+	TestEqual(TEXT("Dictionary hash"), Container.Toc.DictionaryHash, Dictionary.GetHash());
+	TestTrue(TEXT("Each actor starts a block"), Container.Toc.Blocks.Num() >= NumActors);
+
+	// Containers are only read with the project's dictionary, which isn't ours
+	const FSaveGameCompressionDictionary* ProjectDictionary = FSaveGameCompressionDictionary::Get();
+	if (ProjectDictionary && ProjectDictionary->GetHash() == Dictionary.GetHash())
+	{
+		return true;
+	}
+
+	AddExpectedError(TEXT("compression dictionary"), EAutomationExpectedErrorFlags::Contains, 1);
+
+	FSaveGameContainerReader Reader;
+	TestFalse(TEXT("Doesn't open without its dictionary"), Reader.Open(TArray<uint8>(Container.Data)));
+
+	// Its table of contents was still read, so decompress its blocks with the right dictionary ourselves
+	const FSaveGameTableOfContents& Toc = Reader.GetTableOfContents();
+	TArray<uint8> Uncompressed;
+	Uncompressed.SetNumUninitialized(static_cast<int32>(Toc.UncompressedSize));
+
+	for (const FSaveGameTableOfContents::FBlock& TocBlock : Toc.Blocks)
+	{
+		const TConstArrayView<uint8> CompressedBlock(Container.Data.GetData() + TocBlock.CompressedOffset,
+		                                             TocBlock.CompressedSize);
+		const TArrayView<uint8> UncompressedBlock(Uncompressed.GetData() + TocBlock.UncompressedOffset,
+		                                          TocBlock.UncompressedSize);
+
+		if (!FSaveGameCompression::DecompressBlock(CompressedBlock, Toc.CompressionFormat, UncompressedBlock,
+		                                           &Dictionary))
+		{
+			AddError(FString::Printf(TEXT("Block at %llu doesn't decompress"), TocBlock.UncompressedOffset));
+		}
+	}
+
+	TestTrue(TEXT("Container reads back with its dictionary"), Uncompressed == Container.GetUncompressedData());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSaveGameContainerCorruptTest, "SaveGamePlugin.Container.Corrupt",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSaveGameContainerCorruptTest::RunTest(const FString& Parameters)
+{
+	using namespace SaveGameContainerTests;
+
+	// Every way that these containers are broken is logged, as is each block that fails to decompress
+	AddExpectedError(TEXT("Save game container"), EAutomationExpectedErrorFlags::Contains, 0);
+	AddExpectedError(TEXT("Failed to uncompress memory"), EAutomationExpectedErrorFlags::Contains, 0);
+
+	FTestContainer Container;
+	WriteContainer(Container, nullptr);
+
+	const TArray<uint8>& Data = Container.Data;
+	const int64 TocOffset = GetTableOfContentsOffset(Data);
+
+	{
+		FSaveGameContainerReader Reader;
+		if (!TestTrue(TEXT("Intact container opens"), Reader.Open(TArray<uint8>(Data))))
+		{
+			return false;
+		}
+	}
+
+	// Each length through the preamble, summary and table of contents, and a sample of those through the blocks
+	for (int32 Size = 0; Size < Data.Num(); Size += (Size < 256 || Size >= TocOffset) ? 1 : 61)
+	{
+		FSaveGameContainerReader Reader;
+		if (Reader.Open(TArray<uint8>(Data.GetData(), Size)))
+		{
+			AddError(FString::Printf(TEXT("Container truncated to %i bytes opens"), Size));
+		}
+	}
+
+	{
+		TArray<uint8> Garbage = Data;
+		Garbage[0] ^= 0xFF;
+
+		FSaveGameContainerReader Reader;
+		TestFalse(TEXT("Container with a garbage tag doesn't open"), Reader.Open(MoveTemp(Garbage)));
+	}
+
+	{
+		TArray<uint8> MissingToc = Data;
+		FMemory::Memset(MissingToc.GetData() + sizeof(uint32) + sizeof(int32), 0xFF, sizeof(int64));
+
+		FSaveGameContainerReader Reader;
+		TestFalse(TEXT("Container with a bad table of contents offset doesn't open"),
+		          Reader.Open(MoveTemp(MissingToc)));
+	}
+
+	// Tables of contents that read fine, but don't describe the container
+	auto TestCorruptToc = [this, &Container](const TCHAR* What, TFunctionRef<void(FSaveGameTableOfContents&)> Corrupt)
+	{
+		FSaveGameTableOfContents Toc = Container.Toc;
+		Corrupt(Toc);
+
+		FSaveGameContainerReader Reader;
+		if (Reader.Open(ReplaceTableOfContents(Container.Data, MoveTemp(Toc))))
+		{
+			AddError(FString::Printf(TEXT("Container opens with %s"), What));
+		}
+	};
+
+	TestCorruptToc(TEXT("an unknown compression format"), [](FSaveGameTableOfContents& Toc)
+	{
+		Toc.CompressionFormat = TEXT("NotACompressionFormat");
+	});
+	TestCorruptToc(TEXT("a block past its blocks"), [TocOffset](FSaveGameTableOfContents& Toc)
+	{
+		Toc.Blocks.Last().CompressedOffset = static_cast<uint64>(TocOffset);
+	});
+	TestCorruptToc(TEXT("a gap between blocks"), [](FSaveGameTableOfContents& Toc)
+	{
+		++Toc.Blocks.Last().UncompressedOffset;
+	});
+	TestCorruptToc(TEXT("an empty block"), [](FSaveGameTableOfContents& Toc)
+	{
+		Toc.Blocks[0].CompressedSize = 0;
+	});
+	TestCorruptToc(TEXT("more uncompressed data than its blocks"), [](FSaveGameTableOfContents& Toc)
+	{
+		++Toc.UncompressedSize;
+	});
+	TestCorruptToc(TEXT("a section past the end"), [](FSaveGameTableOfContents& Toc)
+	{
+		++Toc.Names.Size;
+	});
+	TestCorruptToc(TEXT("actors out of order"), [](FSaveGameTableOfContents& Toc)
+	{
+		Toc.Levels[0].ActorOffsets.Swap(1, 2);
+	});
+
+	// Blocks aren't checked until they're read, which has to fail rather than crash
+	{
+		TArray<uint8> CorruptBlocks = Data;
+		for (const FSaveGameTableOfContents::FBlock& Block : Container.Toc.Blocks)
+		{
+			CorruptBlocks[static_cast<int32>(Block.CompressedOffset) + Block.CompressedSize / 2] ^= 0xFF;
+		}
+
+		FSaveGameContainerReader Reader;
+		if (TestTrue(TEXT("Container with corrupt blocks opens"), Reader.Open(MoveTemp(CorruptBlocks))))
+		{
+			TArray<uint8> Section;
+			TestFalse(TEXT("Corrupt level doesn't read"), Reader.ReadSection(Container.Toc.Levels[0], Section));
+
+			Reader.ReadSection(Container.Toc.Header, Section);
+			Reader.ReadSection(Container.Toc.Names, Section);
+		}
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,96 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "SaveGameObject.h"
+
+#include "SaveGameVersion.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/StructuredArchive.h"
+#include "Serialization/Formatters/BinaryArchiveFormatter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSaveGameFieldDirectoryTest, "SaveGamePlugin.Object.FieldDirectory",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSaveGameFieldDirectoryTest::RunTest(const FString& Parameters)
+{
+	constexpr uint32 Trailer = 0xC0FFEE;
+
+	TArray<uint8> Data;
+
+	{
+		FMemoryWriter Writer(Data);
+		FBinaryArchiveFormatter Formatter(Writer);
+		FStructuredArchive StructuredArchive(Formatter);
+		FStructuredArchive::FRecord Record = StructuredArchive.Open().EnterRecord();
+
+		{
+			FSaveGameArchive SaveArchive(Record, nullptr);
+
+			int32 Health = 42;
+			FString Name = TEXT("Field Directory");
+			float Scale = 1.5f;
+
+			auto SerializeHealth = [&Health](FStructuredArchive::FSlot Slot) { Slot << Health; };
+			auto SerializeName = [&Name](FStructuredArchive::FSlot Slot) { Slot << Name; };
+			auto SerializeScale = [&Scale](FStructuredArchive::FSlot Slot) { Slot << Scale; };
+
+			SaveArchive.SerializeField(TEXT("Health"), SerializeHealth);
+			SaveArchive.SerializeField(TEXT("Name"), SerializeName);
+			SaveArchive.SerializeField(TEXT("Scale"), SerializeScale);
+
+			TestFalse(TEXT("A field is only saved once"), SaveArchive.SerializeField(TEXT("Health"), SerializeHealth));
+		}
+
+		// Whatever follows the archive is written after its field directory
+		uint32 Value = Trailer;
+		Record << SA_VALUE(TEXT("Trailer"), Value);
+	}
+
+	FMemoryReader Reader(Data);
+	Reader.SetCustomVersion(FSaveGameVersion::GUID, FSaveGameVersion::LatestVersion, TEXT("SaveGameVersion"));
+
+	FBinaryArchiveFormatter Formatter(Reader);
+	FStructuredArchive StructuredArchive(Formatter);
+	FStructuredArchive::FRecord Record = StructuredArchive.Open().EnterRecord();
+
+	{
+		// Without an object, as there's no class to redirect fields with
+		FSaveGameArchive SaveArchive(Record, nullptr);
+
+		int32 Health = 0;
+		FString Name;
+		float Scale = 0.0f;
+		int32 Missing = 0;
+
+		auto SerializeScale = [&Scale](FStructuredArchive::FSlot Slot) { Slot << Scale; };
+		auto SerializeName = [&Name](FStructuredArchive::FSlot Slot) { Slot << Name; };
+		auto SerializeHealth = [&Health](FStructuredArchive::FSlot Slot) { Slot << Health; };
+		auto SerializeMissing = [&Missing](FStructuredArchive::FSlot Slot) { Slot << Missing; };
+
+		// Out of the order they were saved in
+		TestTrue(TEXT("Scale is read"), SaveArchive.SerializeField(TEXT("Scale"), SerializeScale));
+		TestTrue(TEXT("Name is read"), SaveArchive.SerializeField(TEXT("Name"), SerializeName));
+		TestTrue(TEXT("Health is read"), SaveArchive.SerializeField(TEXT("Health"), SerializeHealth));
+		TestFalse(TEXT("Missing field isn't read"), SaveArchive.SerializeField(TEXT("Missing"), SerializeMissing));
+
+		TestEqual(TEXT("Health"), Health, 42);
+		TestEqual(TEXT("Name"), Name, TEXT("Field Directory"));
+		TestEqual(TEXT("Scale"), Scale, 1.5f);
+		TestEqual(TEXT("Missing field is left as it was"), Missing, 0);
+	}
+
+	// The archive seeks past its field directory as it goes out of scope, wherever its fields were read from
+	uint32 Value = 0;
+	Record << SA_VALUE(TEXT("Trailer"), Value);
+
+	TestEqual(TEXT("Value after the archive"), Value, Trailer);
+	TestFalse(TEXT("Reader has no errors"), Reader.IsError());
+	TestEqual(TEXT("Reader is at the end"), Reader.Tell(), Reader.TotalSize());
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,146 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "SaveGameTestActor.h"
+
+#include "SaveGameSettings.h"
+#include "SaveGameSubsystem.h"
+#include "Containers/Ticker.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+#include "UObject/UObjectGlobals.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SaveGameSerializerTests
+{
+	static constexpr int32 NumActors = 12;
+
+	static FName GetActorName(int32 ActorIdx)
+	{
+		return *FString::Printf(TEXT("SaveGameTestActor_Column%i"), ActorIdx);
+	}
+
+	/** Services the game thread work of the subsystem's saves and loads, until they've all completed */
+	static bool WaitForSaveGame(const USaveGameSubsystem* Subsystem)
+	{
+		const double EndTime = FPlatformTime::Seconds() + 30.0;
+
+		while (Subsystem->IsLoadingSaveGame())
+		{
+			if (FPlatformTime::Seconds() > EndTime)
+			{
+				return false;
+			}
+
+			FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+			FTSTicker::GetCoreTicker().Tick(0.0f);
+			FPlatformProcess::Sleep(0.001f);
+		}
+
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSaveGameColumnGroupTest, "SaveGamePlugin.Serializer.ColumnGroups",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSaveGameColumnGroupTest::RunTest(const FString& Parameters)
+{
+	using namespace SaveGameSerializerTests;
+
+	USaveGameSettings* Settings = GetMutableDefault<USaveGameSettings>();
+	const int32 ColumnGroupThreshold = Settings->ColumnGroupThreshold;
+	Settings->ColumnGroupThreshold = NumActors / 2;
+
+	// A world of our own, so that its level can be streamed out and back in without travelling
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->AddToRoot();
+	GameInstance->InitializeStandalone();
+
+	UWorld* World = GameInstance->GetWorld();
+
+	ON_SCOPE_EXIT
+	{
+		Settings->ColumnGroupThreshold = ColumnGroupThreshold;
+
+		GameInstance->Shutdown();
+		GameInstance->RemoveFromRoot();
+
+		World->DestroyWorld(false);
+		GEngine->DestroyWorldContext(World);
+	};
+
+	USaveGameSubsystem* Subsystem = GameInstance->GetSubsystem<USaveGameSubsystem>();
+	if (!TestNotNull(TEXT("Save game subsystem"), Subsystem))
+	{
+		return false;
+	}
+
+	ULevel* Level = World->PersistentLevel;
+
+	// Every third actor is left as it was spawned, so that not every row of a column has a value
+	for (int32 ActorIdx = 0; ActorIdx < NumActors; ++ActorIdx)
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.Name = GetActorName(ActorIdx);
+
+		ASaveGameTestActor* Actor = World->SpawnActor<ASaveGameTestActor>(SpawnParameters);
+		if (ActorIdx % 3 != 0)
+		{
+			Actor->Health = ActorIdx * 10;
+			Actor->Label = FString::Printf(TEXT("Actor %i"), ActorIdx);
+			Actor->Target = FVector(ActorIdx, -ActorIdx, ActorIdx * 0.5);
+		}
+
+		Actor->CustomData = 1000 + ActorIdx;
+	}
+
+	// Streaming the level out snapshots its actors, which are enough to be saved in a column group
+	FWorldDelegates::PreLevelRemovedFromWorld.Broadcast(Level, World);
+
+	// Spawned actors are spawned again when the level's snapshot is loaded, so they're destroyed (and their names are
+	// freed) as if the level had been unloaded
+	for (int32 ActorIdx = 0; ActorIdx < NumActors; ++ActorIdx)
+	{
+		if (AActor* Actor = FindObjectFast<AActor>(Level, GetActorName(ActorIdx)))
+		{
+			Actor->Destroy();
+		}
+	}
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	FWorldDelegates::LevelAddedToWorld.Broadcast(Level, World);
+
+	if (!TestTrue(TEXT("Level snapshot loads"), WaitForSaveGame(Subsystem)))
+	{
+		return false;
+	}
+
+	for (int32 ActorIdx = 0; ActorIdx < NumActors; ++ActorIdx)
+	{
+		const ASaveGameTestActor* Actor = FindObjectFast<ASaveGameTestActor>(Level, GetActorName(ActorIdx));
+		if (!IsValid(Actor))
+		{
+			AddError(FString::Printf(TEXT("Actor %i wasn't respawned"), ActorIdx));
+			continue;
+		}
+
+		const bool bChanged = ActorIdx % 3 != 0;
+		const int32 Health = bChanged ? ActorIdx * 10 : 100;
+		const FString Label = bChanged ? FString::Printf(TEXT("Actor %i"), ActorIdx) : FString();
+		const FVector Target = bChanged ? FVector(ActorIdx, -ActorIdx, ActorIdx * 0.5) : FVector::ZeroVector;
+
+		TestEqual(FString::Printf(TEXT("Actor %i health"), ActorIdx), Actor->Health, Health);
+		TestEqual(FString::Printf(TEXT("Actor %i label"), ActorIdx), Actor->Label, Label);
+		TestEqual(FString::Printf(TEXT("Actor %i target"), ActorIdx), Actor->Target, Target);
+		TestEqual(FString::Printf(TEXT("Actor %i custom data"), ActorIdx), Actor->CustomData, 1000 + ActorIdx);
+	}
+
+	return true;
+}
+
+#endif
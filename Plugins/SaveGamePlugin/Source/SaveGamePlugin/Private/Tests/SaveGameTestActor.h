@@ -0,0 +1,50 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "SaveGameObject.h"
+#include "SaveGameTestActor.generated.h"
+
+/**
+ * An actor with a few kinds of SaveGame properties, and a field of its own in OnSerialize, for the automation tests.
+ */
+UCLASS(NotBlueprintable, NotPlaceable, HideDropdown, Transient)
+class ASaveGameTestActor : public AActor, public ISaveGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(SaveGame)
+	int32 Health = 100;
+
+	UPROPERTY(SaveGame)
+	FString Label;
+
+	UPROPERTY(SaveGame)
+	FVector Target = FVector::ZeroVector;
+
+	/** Not a SaveGame property, so it's only saved by OnSerialize */
+	int32 CustomData = 0;
+
+	virtual bool OnSerialize_Implementation(FSaveGameArchive& Archive, bool bIsLoading) override
+	{
+		Archive.SerializeField(TEXT("CustomData"), [this](FStructuredArchive::FSlot Slot)
+		{
+			Slot << CustomData;
+		});
+
+		return true;
+	}
+
+	virtual bool IsThreadSafe_Implementation() const override
+	{
+		return true;
+	}
+
+	virtual bool CanReuseSaveData_Implementation() const override
+	{
+		return false;
+	}
+};
@@ -0,0 +1,124 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "SaveGameTransform.h"
+
+#include "SaveGameSettings.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/StructuredArchive.h"
+#include "Serialization/Formatters/BinaryArchiveFormatter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SaveGameTransformTests
+{
+	/** Saves and loads a transform, returning how many bytes it was saved as */
+	static int32 RoundTrip(const FTransform& Transform, FTransform& OutLoaded)
+	{
+		TArray<uint8> Data;
+
+		{
+			FMemoryWriter Writer(Data);
+			FBinaryArchiveFormatter Formatter(Writer);
+			FStructuredArchive StructuredArchive(Formatter);
+
+			FTransform Saved = Transform;
+			FSaveGameTransform::Serialize(StructuredArchive.Open(), Saved);
+			StructuredArchive.Close();
+		}
+
+		FMemoryReader Reader(Data);
+		FBinaryArchiveFormatter Formatter(Reader);
+		FStructuredArchive StructuredArchive(Formatter);
+
+		FSaveGameTransform::Serialize(StructuredArchive.Open(), OutLoaded);
+		StructuredArchive.Close();
+
+		return Data.Num();
+	}
+
+	/** Checks a quantized transform against the original, within what quantizing it loses */
+	static void TestQuantized(FAutomationTestBase& Test, const TCHAR* What, const FTransform& Transform)
+	{
+		FTransform Loaded;
+		const int32 Size = RoundTrip(Transform, Loaded);
+
+		// Locations are snapped to the grid, unless they're too far out to fit on it
+		const float Precision = GetDefault<USaveGameSettings>()->TransformPositionPrecision;
+		const double LocationTolerance = FMath::Max(Precision * 0.5, UE_DOUBLE_KINDA_SMALL_NUMBER);
+
+		// Each of the smallest three components is off by at most half a step of an int16 over +/- 1/sqrt(2)
+		constexpr double RotationTolerance = 1.0e-3;
+
+		Test.TestTrue(FString::Printf(TEXT("%s: is smaller than ten doubles"), What),
+		              Size < static_cast<int32>(10 * sizeof(double)));
+		Test.TestTrue(FString::Printf(TEXT("%s: location"), What),
+		              Loaded.GetLocation().Equals(Transform.GetLocation(), LocationTolerance));
+		Test.TestTrue(FString::Printf(TEXT("%s: rotation"), What),
+		              Loaded.GetRotation().AngularDistance(Transform.GetRotation()) < RotationTolerance);
+		Test.TestTrue(FString::Printf(TEXT("%s: scale"), What),
+		              Loaded.GetScale3D().Equals(Transform.GetScale3D(), UE_KINDA_SMALL_NUMBER));
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSaveGameTransformQuantizedTest, "SaveGamePlugin.Transform.Quantized",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSaveGameTransformQuantizedTest::RunTest(const FString& Parameters)
+{
+	using namespace SaveGameTransformTests;
+
+	USaveGameSettings* Settings = GetMutableDefault<USaveGameSettings>();
+	const bool bQuantizeTransforms = Settings->bQuantizeTransforms;
+	Settings->bQuantizeTransforms = true;
+
+	ON_SCOPE_EXIT
+	{
+		Settings->bQuantizeTransforms = bQuantizeTransforms;
+	};
+
+	TestQuantized(*this, TEXT("Identity"), FTransform::Identity);
+	TestQuantized(*this, TEXT("Non-uniform scale"),
+	              FTransform(FRotator(30.0, 45.0, -60.0), FVector(1234.567, -89.012, 345.678), FVector(1.0, 2.0, 0.5)));
+	TestQuantized(*this, TEXT("Uniform scale"),
+	              FTransform(FRotator(-89.0, 179.0, 1.0), FVector(-0.004, 0.006, 100000.0), FVector(3.0)));
+
+	// Its largest component (W) is negative, so the quaternion is flipped to store it
+	TestQuantized(*this, TEXT("Flipped rotation"),
+	              FTransform(FQuat(FVector::UpVector, UE_DOUBLE_PI * 1.9), FVector(10.0, 20.0, 30.0)));
+
+	// Beyond the grid (at any precision), so it's stored as it is
+	TestQuantized(*this, TEXT("Far location"), FTransform(FRotator::ZeroRotator, FVector(1.0e12, -1.0e12, 5.0)));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSaveGameTransformFullPrecisionTest, "SaveGamePlugin.Transform.FullPrecision",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSaveGameTransformFullPrecisionTest::RunTest(const FString& Parameters)
+{
+	using namespace SaveGameTransformTests;
+
+	USaveGameSettings* Settings = GetMutableDefault<USaveGameSettings>();
+	const bool bQuantizeTransforms = Settings->bQuantizeTransforms;
+	Settings->bQuantizeTransforms = false;
+
+	ON_SCOPE_EXIT
+	{
+		Settings->bQuantizeTransforms = bQuantizeTransforms;
+	};
+
+	const FTransform Transform(FRotator(30.0, 45.0, -60.0), FVector(1234.567, -89.012, 345.678), FVector(1.0, 2.0, 0.5));
+
+	FTransform Loaded;
+	RoundTrip(Transform, Loaded);
+
+	TestTrue(TEXT("Transform is loaded as it was saved"), Loaded.Equals(Transform, 0.0));
+
+	return true;
+}
+
+#endif
@@ -5,13 +5,16 @@
 #if WITH_TEXT_ARCHIVE_SUPPORT
 #include "Serialization/StructuredArchiveFormatter.h"
 
-class FJsonObject;
-class FJsonValue;
-
+/**
+ * Writes compact JSON straight into a UTF-8 buffer as the archive is serialized, without building a document.
+ * Fields that are entered but never given a value are left out.
+ */
 class FJsonOutputArchiveFormatter final : public FStructuredArchiveFormatter
 {
 public:
-	TSharedRef<FJsonObject> GetRoot() const { return RootObject.ToSharedRef(); }
+	/** The UTF-8 JSON written so far, which is complete once the root record has been left */
+	const TArray<uint8>& GetText() const { return Text; }
+	TArray<uint8> ReleaseText() { return MoveTemp(Text); }
 
 	virtual FArchive& GetUnderlyingArchive() override;
 	virtual bool HasDocumentTree() const override;
@@ -63,39 +66,47 @@ public:
 	virtual void Serialize(TArray<uint8>& Value) override;
 	virtual void Serialize(void* Data, uint64 DataSize) override;
 
-	void Serialize(const TSharedRef<FJsonObject>& Value);
+	/** Writes already formatted JSON (like the text of another of these formatters) as the current value */
+	void SerializeJson(TConstArrayView<uint8> Json);
+
+	/**
+	 * Writes the next blob as already formatted JSON instead of Base64. For records whose bytes are spliced into
+	 * another archive as a blob, so that they keep their structure.
+	 */
+	void SpliceNextBlob(TConstArrayView<uint8> Json);
 
 private:
-	struct FStackObject
+	struct FScope
 	{
-		FStackObject(const TSharedRef<FJsonObject>& InObject)
-			: Object(InObject)
-			  , bInAttributedValueValue(false)
-			  , bInStream(false)
-		{
-		}
-
-		TSharedRef<FJsonObject> Object;
-		FString Field;
-
-		bool bInAttributedValueValue;
-		bool bInStream;
-		TArray<TSharedPtr<FJsonValue>> StreamValues;
+		bool bIsArray = false;
+		bool bHasValues = false;
 	};
 
-	TSharedPtr<FJsonObject> RootObject;
-	TArray<FStackObject> Stack;
+	TArray<uint8> Text;
+	TArray<FScope, TInlineAllocator<16>> Stack;
+
+	/** The field whose value is next, written out with it so that empty fields are left out */
+	FString PendingField;
+	bool bHasPendingField = false;
+
+	TOptional<TConstArrayView<uint8>> PendingSplice;
 
 	void ObjSerialize(const UObject* Value);
 
-	template <typename ValueType>
-	void SetNumberValue(const ValueType& Value);
+	/** Writes what separates the next value from the previous one, and the name of the field it's for */
+	void BeginValue();
+
+	void EnterScope(bool bIsArray);
+	void LeaveScope();
 
-	template <typename JsonValueType, typename ValueType>
-	void SetValue(const ValueType& Value);
+	template <typename ValueType>
+	void WriteInteger(ValueType Value);
 
-	void SetValue(const TSharedRef<FJsonValue>& Value);
+	template <typename ValueType>
+	void WriteNumber(ValueType Value);
 
-	FStackObject& GetCurrent() { return Stack.Last(); }
+	void WriteString(FStringView Value);
+	void WriteLiteral(FAnsiStringView Value);
+	void WriteUtf8(TConstArrayView<uint8> Value);
 };
 #endif
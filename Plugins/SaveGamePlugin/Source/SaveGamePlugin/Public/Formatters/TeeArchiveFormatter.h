@@ -0,0 +1,311 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#pragma once
+
+#include "Serialization/StructuredArchiveFormatter.h"
+
+/**
+ * Passes every call on to two formatters, like the binary formatter and a text formatter for debugging. The types of
+ * both are known, so the calls are made directly rather than through their virtual functions.
+ * Archives without a second formatter should use the primary formatter by itself, rather than a tee to a null one.
+ */
+template <typename PrimaryType, typename SecondaryType>
+class TTeeArchiveFormatter final : public FStructuredArchiveFormatter
+{
+public:
+	TTeeArchiveFormatter(PrimaryType& InPrimary, SecondaryType& InSecondary)
+		: Primary(InPrimary)
+		  , Secondary(InSecondary)
+	{
+	}
+
+	virtual FArchive& GetUnderlyingArchive() override { return Primary.GetUnderlyingArchive(); }
+
+	virtual bool HasDocumentTree() const override
+	{
+		return Primary.HasDocumentTree() || Secondary.HasDocumentTree();
+	}
+
+	virtual void EnterRecord() override
+	{
+		Primary.EnterRecord();
+		Secondary.EnterRecord();
+	}
+
+	virtual void LeaveRecord() override
+	{
+		Primary.LeaveRecord();
+		Secondary.LeaveRecord();
+	}
+
+	virtual void EnterField(FArchiveFieldName Name) override
+	{
+		Primary.EnterField(Name);
+		Secondary.EnterField(Name);
+	}
+
+	virtual void LeaveField() override
+	{
+		Primary.LeaveField();
+		Secondary.LeaveField();
+	}
+
+	virtual bool TryEnterField(FArchiveFieldName Name, bool bEnterWhenWriting) override
+	{
+		return Primary.TryEnterField(Name, bEnterWhenWriting) && Secondary.TryEnterField(Name, bEnterWhenWriting);
+	}
+
+	virtual void EnterArray(int32& NumElements) override
+	{
+		Primary.EnterArray(NumElements);
+		Secondary.EnterArray(NumElements);
+	}
+
+	virtual void LeaveArray() override
+	{
+		Primary.LeaveArray();
+		Secondary.LeaveArray();
+	}
+
+	virtual void EnterArrayElement() override
+	{
+		Primary.EnterArrayElement();
+		Secondary.EnterArrayElement();
+	}
+
+	virtual void LeaveArrayElement() override
+	{
+		Primary.LeaveArrayElement();
+		Secondary.LeaveArrayElement();
+	}
+
+	virtual void EnterStream() override
+	{
+		Primary.EnterStream();
+		Secondary.EnterStream();
+	}
+
+	virtual void LeaveStream() override
+	{
+		Primary.LeaveStream();
+		Secondary.LeaveStream();
+	}
+
+	virtual void EnterStreamElement() override
+	{
+		Primary.EnterStreamElement();
+		Secondary.EnterStreamElement();
+	}
+
+	virtual void LeaveStreamElement() override
+	{
+		Primary.LeaveStreamElement();
+		Secondary.LeaveStreamElement();
+	}
+
+	virtual void EnterMap(int32& NumElements) override
+	{
+		Primary.EnterMap(NumElements);
+		Secondary.EnterMap(NumElements);
+	}
+
+	virtual void LeaveMap() override
+	{
+		Primary.LeaveMap();
+		Secondary.LeaveMap();
+	}
+
+	virtual void EnterMapElement(FString& Name) override
+	{
+		Primary.EnterMapElement(Name);
+		Secondary.EnterMapElement(Name);
+	}
+
+	virtual void LeaveMapElement() override
+	{
+		Primary.LeaveMapElement();
+		Secondary.LeaveMapElement();
+	}
+
+	virtual void EnterAttributedValue() override
+	{
+		Primary.EnterAttributedValue();
+		Secondary.EnterAttributedValue();
+	}
+
+	virtual void LeaveAttributedValue() override
+	{
+		Primary.LeaveAttributedValue();
+		Secondary.LeaveAttributedValue();
+	}
+
+	virtual void EnterAttribute(FArchiveFieldName AttributeName) override
+	{
+		Primary.EnterAttribute(AttributeName);
+		Secondary.EnterAttribute(AttributeName);
+	}
+
+	virtual void LeaveAttribute() override
+	{
+		Primary.LeaveAttribute();
+		Secondary.LeaveAttribute();
+	}
+
+	virtual void EnterAttributedValueValue() override
+	{
+		Primary.EnterAttributedValueValue();
+		Secondary.EnterAttributedValueValue();
+	}
+
+	virtual bool TryEnterAttribute(FArchiveFieldName AttributeName, bool bEnterWhenWriting) override
+	{
+		return Primary.TryEnterAttribute(AttributeName, bEnterWhenWriting) && Secondary.TryEnterAttribute(AttributeName, bEnterWhenWriting);
+	}
+
+	virtual bool TryEnterAttributedValueValue() override
+	{
+		return Primary.TryEnterAttributedValueValue() && Secondary.TryEnterAttributedValueValue();
+	}
+
+	virtual void Serialize(uint8& Value) override
+	{
+		Primary.Serialize(Value);
+		Secondary.Serialize(Value);
+	}
+
+	virtual void Serialize(uint16& Value) override
+	{
+		Primary.Serialize(Value);
+		Secondary.Serialize(Value);
+	}
+
+	virtual void Serialize(uint32& Value) override
+	{
+		Primary.Serialize(Value);
+		Secondary.Serialize(Value);
+	}
+
+	virtual void Serialize(uint64& Value) override
+	{
+		Primary.Serialize(Value);
+		Secondary.Serialize(Value);
+	}
+
+	virtual void Serialize(int8& Value) override
+	{
+		Primary.Serialize(Value);
+		Secondary.Serialize(Value);
+	}
+
+	virtual void Serialize(int16& Value) override
+	{
+		Primary.Serialize(Value);
+		Secondary.Serialize(Value);
+	}
+
+	virtual void Serialize(int32& Value) override
+	{
+		Primary.Serialize(Value);
+		Secondary.Serialize(Value);
+	}
+
+	virtual void Serialize(int64& Value) override
+	{
+		Primary.Serialize(Value);
+		Secondary.Serialize(Value);
+	}
+
+	virtual void Serialize(float& Value) override
+	{
+		Primary.Serialize(Value);
+		Secondary.Serialize(Value);
+	}
+
+	virtual void Serialize(double& Value) override
+	{
+		Primary.Serialize(Value);
+		Secondary.Serialize(Value);
+	}
+
+	virtual void Serialize(bool& Value) override
+	{
+		Primary.Serialize(Value);
+		Secondary.Serialize(Value);
+	}
+
+	virtual void Serialize(UTF32CHAR& Value) override
+	{
+		Primary.Serialize(Value);
+		Secondary.Serialize(Value);
+	}
+
+	virtual void Serialize(FString& Value) override
+	{
+		Primary.Serialize(Value);
+		Secondary.Serialize(Value);
+	}
+
+	virtual void Serialize(FName& Value) override
+	{
+		Primary.Serialize(Value);
+		Secondary.Serialize(Value);
+	}
+
+	virtual void Serialize(UObject*& Value) override
+	{
+		Primary.Serialize(Value);
+		Secondary.Serialize(Value);
+	}
+
+	virtual void Serialize(FText& Value) override
+	{
+		Primary.Serialize(Value);
+		Secondary.Serialize(Value);
+	}
+
+	virtual void Serialize(FWeakObjectPtr& Value) override
+	{
+		Primary.Serialize(Value);
+		Secondary.Serialize(Value);
+	}
+
+	virtual void Serialize(FSoftObjectPtr& Value) override
+	{
+		Primary.Serialize(Value);
+		Secondary.Serialize(Value);
+	}
+
+	virtual void Serialize(FSoftObjectPath& Value) override
+	{
+		Primary.Serialize(Value);
+		Secondary.Serialize(Value);
+	}
+
+	virtual void Serialize(FLazyObjectPtr& Value) override
+	{
+		Primary.Serialize(Value);
+		Secondary.Serialize(Value);
+	}
+
+	virtual void Serialize(FObjectPtr& Value) override
+	{
+		Primary.Serialize(Value);
+		Secondary.Serialize(Value);
+	}
+
+	virtual void Serialize(TArray<uint8>& Value) override
+	{
+		Primary.Serialize(Value);
+		Secondary.Serialize(Value);
+	}
+
+	virtual void Serialize(void* Data, uint64 DataSize) override
+	{
+		Primary.Serialize(Data, DataSize);
+		Secondary.Serialize(Data, DataSize);
+	}
+
+private:
+	PrimaryType& Primary;
+	SecondaryType& Secondary;
+};
@@ -4,10 +4,14 @@
 
 #include "Serialization/StructuredArchiveFormatter.h"
 
-class FProxyArchiveFormatter : public FStructuredArchiveFormatter
+/**
+ * Logs every call (to LogSaveGameFormatterTrace, at Verbose) before passing it on to another formatter.
+ * Opt in to it with USE_TRACING_FORMATTER, so that it costs nothing otherwise.
+ */
+class FTracingArchiveFormatter final : public FStructuredArchiveFormatter
 {
 public:
-	FProxyArchiveFormatter(FStructuredArchiveFormatter& InPrimary, FStructuredArchiveFormatter& InSecondary);
+	explicit FTracingArchiveFormatter(FStructuredArchiveFormatter& InInner);
 
 	virtual FArchive& GetUnderlyingArchive() override;
 	virtual bool HasDocumentTree() const override;
@@ -59,8 +63,7 @@ public:
 	virtual void Serialize(TArray<uint8>& Value) override;
 	virtual void Serialize(void* Data, uint64 DataSize) override;
 
-protected:
+private:
 	int32 StackDepth;
-	FStructuredArchiveFormatter& Primary;
-	FStructuredArchiveFormatter* Secondary;
+	FStructuredArchiveFormatter& Inner;
 };
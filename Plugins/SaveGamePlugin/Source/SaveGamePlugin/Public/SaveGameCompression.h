@@ -0,0 +1,53 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class ESaveGameCompressionLevel : uint8;
+
+/**
+ * A Zlib preset dictionary, trained on representative save data (see USaveGameTrainDictionaryCommandlet). Small blocks,
+ * like a single actor's data, compress poorly on their own, as there's no history to reference. Priming the compressor
+ * with a dictionary gives these blocks a ratio close to that of compressing the whole save at once.
+ */
+class SAVEGAMEPLUGIN_API FSaveGameCompressionDictionary
+{
+public:
+	/** Zlib can only reference data within its 32KB window, anything larger is wasted */
+	static constexpr int32 MaxSize = 32 * 1024;
+
+	explicit FSaveGameCompressionDictionary(TArray<uint8>&& InData);
+
+	/** Get the project's dictionary (see USaveGameSettings::CompressionDictionary), null if there isn't one */
+	static const FSaveGameCompressionDictionary* Get();
+
+	/** Builds a dictionary out of the byte sequences that are shared by the most samples */
+	static TArray<uint8> Train(TConstArrayView<TConstArrayView<uint8>> Samples, int32 DictionarySize = MaxSize);
+
+	TConstArrayView<uint8> GetData() const { return Data; }
+
+	/** Identifies the dictionary that a container was compressed with, never 0 */
+	uint32 GetHash() const { return Hash; }
+
+private:
+	TArray<uint8> Data;
+	uint32 Hash;
+};
+
+/** Compresses and decompresses the individual blocks of a save game container */
+class SAVEGAMEPLUGIN_API FSaveGameCompression
+{
+public:
+	/**
+	 * Compresses a single block, storing it uncompressed if compression didn't make it any smaller.
+	 * A dictionary can only be used with Zlib, and the same dictionary must be used to decompress the block.
+	 */
+	static void CompressBlock(TConstArrayView<uint8> Block, FName Format, ESaveGameCompressionLevel Level,
+	                          TArray<uint8>& OutCompressed,
+	                          const FSaveGameCompressionDictionary* Dictionary = nullptr);
+
+	/** Decompresses a single block into OutBlock, which must already be sized to the uncompressed size */
+	static bool DecompressBlock(TConstArrayView<uint8> Compressed, FName Format, TArrayView<uint8> OutBlock,
+	                            const FSaveGameCompressionDictionary* Dictionary = nullptr);
+};
@@ -0,0 +1,279 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Memory/SharedBuffer.h"
+#include "Misc/EngineVersion.h"
+#include "Tasks/Task.h"
+
+enum class ESaveGameCompressionLevel : uint8;
+class FSaveGameCompressionDictionary;
+class FSaveGameFileWriter;
+class IAsyncReadFileHandle;
+
+/**
+ * Uncompressed index of a save game container. Sections are ranges of the uncompressed save data, blocks are the
+ * independently compressed ranges that make up the uncompressed data. A loader can use this to only decompress the
+ * blocks that a section needs.
+ */
+struct SAVEGAMEPLUGIN_API FSaveGameTableOfContents
+{
+	struct FSection
+	{
+		uint64 Offset = 0;
+		uint64 Size = 0;
+
+		friend FArchive& operator<<(FArchive& Ar, FSection& Section)
+		{
+			return Ar << Section.Offset << Section.Size;
+		}
+	};
+
+	struct FLevelSection : FSection
+	{
+		/** The level's top level asset path */
+		FString Name;
+
+		/** Offsets of each actor's data, relative to the start of the level section */
+		TArray<uint32> ActorOffsets;
+
+		/** Get the range of an actor's data, relative to the start of the uncompressed data */
+		FSection GetActorSection(int32 ActorIdx) const;
+
+		friend FArchive& operator<<(FArchive& Ar, FLevelSection& Section)
+		{
+			Ar << Section.Name;
+			Ar << static_cast<FSection&>(Section);
+			return Ar << Section.ActorOffsets;
+		}
+	};
+
+	struct FBlock
+	{
+		uint64 CompressedOffset = 0;
+		uint64 UncompressedOffset = 0;
+		int32 CompressedSize = 0;
+		int32 UncompressedSize = 0;
+
+		friend FArchive& operator<<(FArchive& Ar, FBlock& Block)
+		{
+			return Ar << Block.CompressedOffset << Block.UncompressedOffset << Block.CompressedSize << Block.UncompressedSize;
+		}
+	};
+
+	FName CompressionFormat;
+	uint64 UncompressedSize = 0;
+
+	/** Hash of the dictionary that the blocks were compressed with, 0 if none was used */
+	uint32 DictionaryHash = 0;
+	TArray<FBlock> Blocks;
+
+	FSection Header;
+	FSection Versions;
+	TArray<FLevelSection> Levels;
+
+	/** The save's name table, empty for containers that predate it */
+	FSection Names;
+
+	/** Get the range of blocks that contain the section */
+	void GetBlockRange(const FSection& Section, int32& OutFirstBlock, int32& OutNumBlocks) const;
+
+	/**
+	 * Returns false if the table can't describe a container that ends its blocks by BlocksEnd: the blocks must cover
+	 * the uncompressed data from start to end without gaps, and every section must be within it.
+	 */
+	bool IsValid(uint64 BlocksEnd) const;
+
+	/** Returns true if the section is within the uncompressed data, and isn't too large to be read into an array */
+	bool IsValidSection(const FSection& Section) const;
+
+	void Serialize(FArchive& Ar, int32 ContainerVersion);
+};
+
+/**
+ * What a save slot is shown with, stored uncompressed at the start of the container so that it can be read without
+ * reading (or decompressing) the rest of the container.
+ */
+struct SAVEGAMEPLUGIN_API FSaveGameSummary
+{
+	/** When the save was made, in UTC */
+	FDateTime Timestamp;
+	FString LastVisitedMap;
+
+	/** Unpaused seconds played, see USaveGameSubsystem::GetPlayTime */
+	double PlayTime = 0.0;
+	FEngineVersion EngineVersion;
+
+	friend FArchive& operator<<(FArchive& Ar, FSaveGameSummary& Summary)
+	{
+		return Ar << Summary.Timestamp << Summary.LastVisitedMap << Summary.PlayTime << Summary.EngineVersion;
+	}
+};
+
+/**
+ * A save game container, which is laid out as:
+ *
+ *  ─ ContainerTag
+ *  ─ ContainerVersion
+ *  ─ TableOfContentsOffset
+ *  ─ SummarySize
+ *  ─ Summary (uncompressed)
+ *  ─ Blocks (compressed data)
+ *  ─ TableOfContents
+ *
+ * The table of contents is written last, so that blocks can be written as they're compressed.
+ */
+class SAVEGAMEPLUGIN_API FSaveGameContainer
+{
+public:
+	enum EVersion : int32
+	{
+		Initial = 1,
+
+		// The table of contents stores the hash of the compression dictionary
+		CompressionDictionary,
+
+		// The table of contents stores where the name table is
+		NameTable,
+
+		// The preamble is followed by an uncompressed summary of the save
+		Summary,
+
+		// The name table marks which of its paths were saved by object references
+		ObjectReferences,
+
+		// -----<new versions can be added above this line>-------------------------------------------------
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	static const uint32 ContainerTag;
+
+	/** Where the generic save game system stores a save game, which we can stream from (and write to) directly */
+	static FString GetFilePath(const FString& SaveName);
+
+	/** Returns true if the platform's save game system is the generic one, whose save games are at GetFilePath */
+	static bool UsesGenericSaveGameSystem();
+
+	/** Size of the ContainerTag, ContainerVersion and TableOfContentsOffset */
+	static constexpr int64 PreambleSize = sizeof(uint32) + sizeof(int32) + sizeof(int64);
+
+	/** Summaries larger than this are treated as corrupt */
+	static constexpr int32 MaxSummarySize = 64 * 1024;
+};
+
+/**
+ * Compresses save data into a container as it's written. Each block is compressed in the background as soon as it's
+ * complete, and written to the archive (in order) once compressed, so the archive should be safe to write to from
+ * any thread. Written buffers aren't copied, blocks reference them (or the parts of them that they're made of) until
+ * they've been compressed.
+ */
+class SAVEGAMEPLUGIN_API FSaveGameContainerWriter
+{
+public:
+	/** Writes the preamble and summary straight away, as they're at the start of the container */
+	FSaveGameContainerWriter(FArchive& InArchive, FSaveGameSummary Summary, FName InFormat,
+	                         ESaveGameCompressionLevel InLevel, int32 InBlockSize,
+	                         const FSaveGameCompressionDictionary* InDictionary = nullptr);
+
+	/** Hands the compressed blocks to the file writer as they are, rather than having it copy them */
+	FSaveGameContainerWriter(FSaveGameFileWriter& InFileWriter, FSaveGameSummary Summary, FName InFormat,
+	                         ESaveGameCompressionLevel InLevel, int32 InBlockSize,
+	                         const FSaveGameCompressionDictionary* InDictionary = nullptr);
+	~FSaveGameContainerWriter();
+
+	/**
+	 * Appends a buffer to the container, starting a new block whenever the current one is full. A block made of
+	 * several buffers is gathered right before it's compressed, on the compressing task worker.
+	 */
+	void Write(const FSharedBuffer& Data);
+
+	/** Ends the current block, so that the data written so far can be decompressed separately to what follows */
+	void Flush();
+
+	/** Returns true if blocks are compressed with a dictionary, which is only supported by Zlib */
+	bool UsesDictionary() const { return Dictionary != nullptr; }
+
+	/** Waits for the remaining blocks, then writes the table of contents (with the sections filled out by the caller) */
+	void Finalize(FSaveGameTableOfContents& Toc);
+
+private:
+	FArchive& Archive;
+	FSaveGameFileWriter* FileWriter = nullptr;
+	FName Format;
+	ESaveGameCompressionLevel Level;
+	int32 BlockSize;
+	const FSaveGameCompressionDictionary* Dictionary;
+
+	/** The buffers (or parts of them) that haven't filled a block yet */
+	TArray<FSharedBuffer> PendingBuffers;
+	int32 PendingSize = 0;
+	uint64 UncompressedSize = 0;
+
+	/** The last block's write, each block's write waits for the previous one so that they're written in order */
+	UE::Tasks::FTask WriteTask;
+	TArray<FSaveGameTableOfContents::FBlock> Blocks;
+};
+
+/**
+ * Reads the table of contents of a container, and decompresses sections of it on demand. Containers can be streamed
+ * from a file, in which case only the blocks of requested sections are read (and never all at once).
+ */
+class SAVEGAMEPLUGIN_API FSaveGameContainerReader
+{
+public:
+	~FSaveGameContainerReader();
+
+	/** Opens a container file for streaming, and reads its table of contents */
+	bool Open(const FString& FilePath);
+
+	/** Takes ownership of the container's data and reads its table of contents */
+	bool Open(TArray<uint8>&& InContainerData);
+
+	/** Opens a container file, but only reads its preamble and summary. No sections can be read */
+	bool OpenSummary(const FString& FilePath);
+
+	/** Releases the container's file (or data), no more sections can be read */
+	void Close();
+
+	const FSaveGameTableOfContents& GetTableOfContents() const { return Toc; }
+
+	/** The container's summary, unset if the container predates it */
+	const TOptional<FSaveGameSummary>& GetSummary() const { return Summary; }
+
+	/** The container's version (see FSaveGameContainer::EVersion), once opened */
+	int32 GetVersion() const { return Version; }
+
+	/**
+	 * Reads the section's blocks and decompresses them (in parallel) into OutData, which is sized to the section.
+	 * Each block is decompressed by a task that's released once its read completes, after which its compressed data
+	 * is released.
+	 * Not thread-safe, sections should be read one after the other.
+	 */
+	bool ReadSection(const FSaveGameTableOfContents::FSection& Section, TArray<uint8>& OutData);
+
+private:
+	/** Opens the container's file, returning its size (or INDEX_NONE if it couldn't be opened) */
+	int64 OpenFile(const FString& FilePath);
+
+	/** Reads the preamble and summary, returning the table of contents offset (or INDEX_NONE if it's invalid) */
+	int64 ReadPreamble(int64 ContainerSize);
+
+	/** Reads the preamble and table of contents, once the container's file (or data) is available */
+	bool ReadTableOfContents(int64 ContainerSize);
+
+	/** Reads a range of the container, blocking until it has been read */
+	bool ReadRange(int64 Offset, int64 Size, TArray<uint8>& OutData);
+
+	TUniquePtr<IAsyncReadFileHandle> FileHandle;
+	TArray<uint8> ContainerData;
+	FSaveGameTableOfContents Toc;
+	TOptional<FSaveGameSummary> Summary;
+	int32 Version = 0;
+	const FSaveGameCompressionDictionary* Dictionary = nullptr;
+
+	/** The last block of the last section read, as the next section will usually start in it */
+	int32 CachedBlockIdx = INDEX_NONE;
+	TArray<uint8> CachedBlock;
+};
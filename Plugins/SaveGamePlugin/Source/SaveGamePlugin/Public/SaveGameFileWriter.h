@@ -0,0 +1,76 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Memory/SharedBuffer.h"
+#include "Tasks/Pipe.h"
+
+class IFileHandle;
+
+/**
+ * Writes a file behind its writer. What's written is gathered into large chunks, which are written out in order on
+ * the writer's I/O pipe while the writer carries on. Buffers handed over with Write are written where they are, only
+ * small writes are copied together. The file is written under a temporary name, and only replaces the file at its path
+ * once it has been completely written (see Commit).
+ *
+ * Writes and seeks must come from one thread at a time, though that thread doesn't need to be the same each time.
+ */
+class SAVEGAMEPLUGIN_API FSaveGameFileWriter final : public FArchive
+{
+public:
+	/** Opens the temporary file that we write to, IsError() is set if it couldn't be */
+	explicit FSaveGameFileWriter(const FString& InFilePath);
+
+	/** Waits for outstanding writes, and deletes the temporary file if it wasn't committed */
+	virtual ~FSaveGameFileWriter() override;
+
+	virtual void Serialize(void* Data, int64 Num) override;
+	virtual void Seek(int64 InPos) override;
+	virtual int64 Tell() override { return Pos; }
+	virtual int64 TotalSize() override { return Size; }
+	virtual FString GetArchiveName() const override { return FilePath; }
+
+	/** Appends a buffer without copying it, it's referenced until it has been written */
+	void Write(FSharedBuffer Buffer);
+
+	/**
+	 * Writes out what's left, then replaces the file at our path with the temporary one. Nothing more can be written.
+	 * The task's result is whether the file was completely written and replaced.
+	 *
+	 * The replacement isn't atomic on every platform: IFileManager::Move deletes the previous file before moving the
+	 * temporary one into place, so a crash in between leaves only the temporary file (which is complete).
+	 */
+	UE::Tasks::TTask<bool> Commit();
+
+private:
+	/** Adds the small writes gathered so far to the current chunk as a buffer of their own */
+	void EndSmallWrites();
+
+	/** Hands the current chunk to the I/O pipe */
+	void FlushChunk();
+
+	/** Chunks are handed to the I/O pipe once they reach this size, so that the file is written in few large writes */
+	static constexpr int64 ChunkSize = 1024 * 1024;
+
+	/** Writes smaller than this are copied together, larger ones are copied into a buffer of their own */
+	static constexpr int64 SmallWriteSize = 64 * 1024;
+
+	FString FilePath;
+	FString TempFilePath;
+
+	/** Only used on the I/O pipe, once opened */
+	TUniquePtr<IFileHandle> Handle;
+	UE::Tasks::FPipe IoPipe = UE::Tasks::FPipe(TEXT("SaveGameFileWriter"));
+	std::atomic<bool> bWriteFailed = false;
+
+	/** The buffers of the current chunk, which are written one after another from ChunkOffset */
+	TArray<FSharedBuffer> Chunk;
+	TArray<uint8> SmallWrites;
+	int64 ChunkOffset = 0;
+	int64 ChunkNum = 0;
+
+	int64 Pos = 0;
+	int64 Size = 0;
+	bool bCommitted = false;
+};
@@ -0,0 +1,130 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/ObjectKey.h"
+
+/**
+ * A map that can be searched and added to from many threads. It's split into shards, each behind its own lock, so
+ * that threads rarely contend on the same lock.
+ */
+template <typename KeyType>
+class TSaveGameConcurrentIndexMap
+{
+public:
+	/** Get the index of a key, calling MakeIndex (under the lock of its shard) to get one if it isn't in the map */
+	template <typename FuncType>
+	uint32 FindOrAdd(const KeyType& Key, FuncType&& MakeIndex)
+	{
+		const uint32 Hash = GetTypeHash(Key);
+		FShard& Shard = Shards[Hash % NumShards];
+
+		{
+			FReadScopeLock ReadLock(Shard.Lock);
+			if (const uint32* Index = Shard.Map.FindByHash(Hash, Key))
+			{
+				return *Index;
+			}
+		}
+
+		FWriteScopeLock WriteLock(Shard.Lock);
+
+		// Another thread may have added it while we were waiting for the lock
+		if (const uint32* Index = Shard.Map.FindByHash(Hash, Key))
+		{
+			return *Index;
+		}
+
+		const uint32 Index = MakeIndex();
+		Shard.Map.AddByHash(Hash, Key, Index);
+		return Index;
+	}
+
+	void Reset()
+	{
+		for (FShard& Shard : Shards)
+		{
+			Shard.Map.Reset();
+		}
+	}
+
+private:
+	static constexpr int32 NumShards = 16;
+
+	struct FShard
+	{
+		FRWLock Lock;
+		TMap<KeyType, uint32> Map;
+	};
+
+	FShard Shards[NumShards];
+};
+
+/**
+ * The names and object paths of a save, each stored once and referenced by index, as most are repeated many times
+ * (like the level that each actor reference is in, or the class of each spawned actor).
+ *
+ * Paths are stored as the names of their level (or other top level asset) and their path within it, so paths within
+ * the same level share its names. When saving, the table can be added to from any thread, and object references are
+ * cached so that their paths only need to be built once. When loading, the table is read only, but it can be saved to
+ * once loaded (as saves carry on with the table that pending levels reference).
+ */
+class SAVEGAMEPLUGIN_API FSaveGameNameTable
+{
+public:
+	/** When saving, get the index of a name, adding it if it isn't in the table */
+	uint32 AddName(FName Name);
+
+	/** When saving, get the index of a path, adding it if it isn't in the table */
+	uint32 AddPath(const FSoftObjectPath& Path);
+
+	/** When saving, get the index of an object's path, which is cached per object and marked as an object path */
+	uint32 AddObject(const UObject* Object);
+
+	/** When saving, get the index of a path whose object has to be loaded when loading, marking it as an object path */
+	uint32 AddObjectPath(const FSoftObjectPath& Path);
+
+	/** When loading, get a name by its index (or None if it's out of range) */
+	FName GetName(uint32 Index) const;
+
+	/** When loading, get a path by its index (or a null path if it's out of range) */
+	const FSoftObjectPath& GetPath(uint32 Index) const;
+
+	int32 NumPaths() const { return Paths.Num(); }
+
+	/**
+	 * When loading, whether the path's object has to be loaded, as an object reference was saved as the path (rather
+	 * than only soft references), or it's the class of a spawned actor. Together they're what the save needs loaded
+	 * before its actors are applied. Always false for saves that predate this being stored.
+	 */
+	bool IsObjectPath(uint32 Index) const { return ObjectPaths.IsValidIndex(Index) && ObjectPaths[Index]; }
+
+	/** Serializes the table, as stored by the given container version (see FSaveGameContainer::EVersion) */
+	void Serialize(FArchive& Ar, int32 ContainerVersion);
+
+	/** Empties the table, which mustn't be in use */
+	void Reset();
+
+	/**
+	 * Forgets the paths of objects added with AddObject (their names and paths are kept), so that the objects of past
+	 * saves aren't held on to. The table mustn't be in use.
+	 */
+	void ResetObjects() { ObjectIndices.Reset(); }
+
+private:
+	TArray<FName> Names;
+	TArray<FSoftObjectPath> Paths;
+
+	/** Which of the paths are object paths, see IsObjectPath */
+	TBitArray<> ObjectPaths;
+
+	/** Guard adding to Names and Paths, which are only appended to (PathsLock also guards ObjectPaths) */
+	FCriticalSection NamesLock;
+	FCriticalSection PathsLock;
+
+	TSaveGameConcurrentIndexMap<FName> NameIndices;
+	TSaveGameConcurrentIndexMap<FSoftObjectPath> PathIndices;
+	TSaveGameConcurrentIndexMap<FObjectKey> ObjectIndices;
+};
@@ -10,11 +10,15 @@
  * The blueprint representation of the structured record we're writing to.
  *
  * When serializing a binary archive, FSaveGameArchive on construction will store its initial position that it started
- * serializing from. Once FSaveGameArchive loses scope and calls its destructor, it will then serialize all of the
- * field names and their offsets, if loading, it will automatically seek to the very end of the archive. The initial
+ * serializing from. Once FSaveGameArchive loses scope and calls its destructor, it will then serialize a directory of
+ * the field names and their offsets, if loading, it will automatically seek to the very end of the archive. The initial
  * position and stored offsets can be used for out-of-order seeking to each of the archive's serialized fields.
  *
- * Additionally, when loading, these field names are checked against CoreRedirects and redirected if needed.
+ * The directory is kept small, as OnSerialize payloads often are too. Its names go through the archive (so they're
+ * indices into the save's name table) and its offsets are packed, as the difference from the previous field's.
+ *
+ * Additionally, when loading, these field names are checked against CoreRedirects and redirected if needed. The
+ * redirects are resolved once per class and field name, rather than for every object.
  */
 USTRUCT(BlueprintType, BlueprintInternalUseOnly)
 struct SAVEGAMEPLUGIN_API FSaveGameArchive
@@ -58,7 +62,9 @@ public:
 
 		FArchive& Archive = Record->GetUnderlyingArchive();
 
-		if (Archive.IsSaving() && Fields.Contains(FieldName))
+		const uint32* FieldOffset = FindField(FieldName);
+
+		if (Archive.IsSaving() && FieldOffset)
 		{
 			// We don't want to double up on saving the same property
 			return false;
@@ -69,21 +75,23 @@ public:
 		{
 			if (Archive.IsLoading())
 			{
-				if (!Fields.Contains(FieldName))
+				if (!FieldOffset)
 				{
 					return false;
 				}
 
-				Archive.Seek(StartPosition + Fields[FieldName]);
+				Archive.Seek(StartPosition + *FieldOffset);
 			}
 			else
 			{
 				// Use an offset, in case we need to shuffle data around later!
-				Fields.Add(FieldName, Archive.Tell() - StartPosition);
+				Fields.Emplace(FieldName, IntCastChecked<uint32>(Archive.Tell() - StartPosition));
 			}
 		}
 
-		SerializeFunction(Record->EnterField(*FieldName.ToString()));
+		// Built on the stack, as this is called for every field
+		const FNameBuilder FieldNameString(FieldName);
+		SerializeFunction(Record->EnterField(*FieldNameString));
 
 		return true;
 	}
@@ -91,13 +99,25 @@ public:
 private:
 	FSaveGameArchive(FSaveGameArchive&) = delete;
 
+	const uint32* FindField(FName FieldName) const
+	{
+		const TPair<FName, uint32>* Field = Fields.FindByPredicate([FieldName](const TPair<FName, uint32>& Pair)
+		{
+			return Pair.Key == FieldName;
+		});
+		return Field ? &Field->Value : nullptr;
+	}
+
+	/** Reads the directory of saves that predate FSaveGameVersion::FieldDirectory */
+	void SerializeLegacyFields(FArchive& Archive);
+
 	class FStructuredArchive::FRecord* Record;
 	TWeakObjectPtr<> Object;
 	uint64 StartPosition;
 	uint64 EndPosition;
 
-	/** This serialized fields and their offsets from the start of this archive */
-	TMap<FName, uint64> Fields;
+	/** This serialized fields and their offsets from the start of this archive, in the order they were saved */
+	TArray<TPair<FName, uint32>, TInlineAllocator<8>> Fields;
 };
 
 // Ensure that our archive can't be copied
@@ -142,6 +162,15 @@ public:
 	 */
 	UFUNCTION(BlueprintNativeEvent, Category=SaveGame, meta=(BlueprintThreadSafe))
 	bool IsThreadSafe() const;
+
+	/**
+	 * Returns true if incremental saves (see USaveGameSettings::bIncrementalSaves) can reuse this actor's data for as
+	 * long as its SaveGame properties and transform haven't changed. What's serialized in OnSerialize isn't compared,
+	 * so an actor that serializes other state there must mark itself dirty when that state changes (see
+	 * USaveGameSubsystem::MarkActorDirty). Must be implemented in a thread-safe fashion, like IsThreadSafe.
+	 */
+	UFUNCTION(BlueprintNativeEvent, Category=SaveGame, meta=(BlueprintThreadSafe))
+	bool CanReuseSaveData() const;
 };
 
 UINTERFACE(MinimalAPI)
@@ -2,18 +2,168 @@
 
 #pragma once
 
+#include "SaveGameNameTable.h"
 #include "Serialization/NameAsStringProxyArchive.h"
 
+/**
+ * Object path redirects, grouped by the level (top level asset) that the redirected path belongs to.
+ * Each level chunk of a save game archive owns its own set of redirects, but lookups can cross levels.
+ *
+ * Redirects are added while actors are being initialized, and looked up while they're being serialized, so they're
+ * staged as they're added and only published once the actors have been initialized (see Freeze). Lookups don't take a
+ * lock, as the published redirects don't change while they're being looked up.
+ *
+ * Once frozen, what each path of a name table resolves to can also be cached (see CacheReferences), as a save
+ * references the same objects many times over.
+ */
+class FSaveGameRedirects
+{
+public:
+	/** Stages a redirect, from any thread. It isn't found until the redirects are frozen */
+	void Add(const FSoftObjectPath& From, const FSoftObjectPath& To)
+	{
+		FScopeLock Lock(&StagedLock);
+		Staged.Emplace(From, To);
+	}
+
+	/** Stages the published redirects of another, such as those of the load that left a level pending */
+	void Append(const FSaveGameRedirects& Other)
+	{
+		FScopeLock Lock(&StagedLock);
+
+		for (const TPair<FTopLevelAssetPath, TMap<FSoftObjectPath, FSoftObjectPath>>& Level : Other.Levels)
+		{
+			for (const TPair<FSoftObjectPath, FSoftObjectPath>& Redirect : Level.Value)
+			{
+				Staged.Emplace(Redirect.Key, Redirect.Value);
+			}
+		}
+	}
+
+	/** Publishes the staged redirects, which mustn't be done while any are being looked up */
+	void Freeze()
+	{
+		FScopeLock Lock(&StagedLock);
+
+		for (const TPair<FSoftObjectPath, FSoftObjectPath>& Redirect : Staged)
+		{
+			Levels.FindOrAdd(Redirect.Key.GetAssetPath()).Add(Redirect.Key, Redirect.Value);
+		}
+
+		Staged.Reset();
+	}
+
+	const FSoftObjectPath* Find(const FSoftObjectPath& Path) const
+	{
+		const TMap<FSoftObjectPath, FSoftObjectPath>* LevelRedirects = Levels.Find(Path.GetAssetPath());
+		return LevelRedirects ? LevelRedirects->Find(Path) : nullptr;
+	}
+
+	/** Applies core redirects and our own to a loaded path */
+	void Resolve(FSoftObjectPath& Path) const
+	{
+		// If we have a defined core redirect, make sure that it's applied
+		if (!Path.IsNull())
+		{
+			Path.FixupCoreRedirects();
+		}
+
+		if (const FSoftObjectPath* Redirect = Find(Path))
+		{
+			// Actually perform the redirect
+			Path = *Redirect;
+		}
+	}
+
+	/** What a name table path resolved to. Object is unset if it wasn't found when the path was first resolved */
+	struct FReference
+	{
+		FSoftObjectPath Path;
+		FWeakObjectPtr Object;
+	};
+
+	/** Starts caching what the paths of a name table (with this many paths) resolve to, once we've been frozen */
+	void CacheReferences(int32 NumPaths)
+	{
+		check(Staged.IsEmpty());
+
+		References = MakeUnique<FReferenceSlot[]>(NumPaths);
+		NumReferences = NumPaths;
+	}
+
+	/**
+	 * Finds what a name table path resolved to. If it isn't cached yet, bOutShouldCache is set when the caller is the
+	 * first to ask for it, in which case it should resolve the path and cache it (see CacheReference).
+	 */
+	const FReference* FindReference(uint32 Index, bool& bOutShouldCache)
+	{
+		bOutShouldCache = false;
+
+		if (Index >= static_cast<uint32>(NumReferences))
+		{
+			return nullptr;
+		}
+
+		FReferenceSlot& Slot = References[Index];
+		EReferenceState State = Slot.State.load(std::memory_order_acquire);
+
+		if (State == EReferenceState::Resolved)
+		{
+			return &Slot;
+		}
+
+		// Anyone else asking while it's being resolved resolves it themselves, rather than waiting
+		bOutShouldCache = State == EReferenceState::Unresolved
+			&& Slot.State.compare_exchange_strong(State, EReferenceState::Resolving, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	/** Caches what a name table path resolved to, after FindReference asked for it to be */
+	void CacheReference(uint32 Index, const FSoftObjectPath& Path, UObject* Object)
+	{
+		FReferenceSlot& Slot = References[Index];
+		check(Slot.State.load(std::memory_order_relaxed) == EReferenceState::Resolving);
+
+		Slot.Path = Path;
+		Slot.Object = Object;
+		Slot.State.store(EReferenceState::Resolved, std::memory_order_release);
+	}
+
+private:
+	TMap<FTopLevelAssetPath, TMap<FSoftObjectPath, FSoftObjectPath>> Levels;
+
+	FCriticalSection StagedLock;
+	TArray<TPair<FSoftObjectPath, FSoftObjectPath>> Staged;
+	enum class EReferenceState : uint8
+	{
+		Unresolved,
+		Resolving,
+		Resolved
+	};
+
+	struct FReferenceSlot : FReference
+	{
+		std::atomic<EReferenceState> State = EReferenceState::Unresolved;
+	};
+
+	/** Indexed by name table path, published by each slot's State */
+	TUniquePtr<FReferenceSlot[]> References;
+	int32 NumReferences = 0;
+};
+
 /**
  * A proxy archive that ensures that all object reference types are stored as a SoftObjectPath.
  * Also has a utility for redirecting those references (used for redirecting spawned actors).
+ * With a name table, names and paths are stored as indices into it, otherwise they're stored as strings.
  */
 template <bool bIsLoading>
 struct TSaveGameProxyArchive : public FNameAsStringProxyArchive
 {
-	TSaveGameProxyArchive(FArchive& InInnerArchive, TMap<FSoftObjectPath, FSoftObjectPath>& InRedirects)
+	TSaveGameProxyArchive(FArchive& InInnerArchive, FSaveGameRedirects& InRedirects,
+	                      FSaveGameNameTable* InNameTable = nullptr)
 		: FNameAsStringProxyArchive(InInnerArchive)
 		  , Redirects(InRedirects)
+		  , NameTable(InNameTable)
 	{
 		// Setting this hints a ObjSerialize method to only serialize SaveGame properties
 		ArIsSaveGame = true;
@@ -28,20 +178,39 @@ struct TSaveGameProxyArchive : public FNameAsStringProxyArchive
 		}
 	}
 
-	virtual FArchive& operator<<(FSoftObjectPath& Value) override
+	virtual FArchive& operator<<(FName& Value) override
 	{
-		Value.SerializePath(*this);
+		if (!NameTable)
+		{
+			return FNameAsStringProxyArchive::operator<<(Value);
+		}
 
-		// If we have a defined core redirect, make sure that it's applied
-		if (bIsLoading && !Value.IsNull())
+		uint32 Index = bIsLoading ? 0 : NameTable->AddName(Value);
+		SerializeIntPacked(Index);
+
+		if (bIsLoading)
 		{
-			Value.FixupCoreRedirects();
+			Value = NameTable->GetName(Index);
 		}
 
-		if (bIsLoading && Redirects.Contains(Value))
+		return *this;
+	}
+
+	virtual FArchive& operator<<(FSoftObjectPath& Value) override
+	{
+		if (bIsLoading)
 		{
-			// Actually perform the redirect
-			Value = Redirects[Value];
+			UObject* Object = nullptr;
+			LoadPath(Value, Object);
+		}
+		else if (NameTable)
+		{
+			uint32 Index = NameTable->AddPath(Value);
+			SerializeIntPacked(Index);
+		}
+		else
+		{
+			Value.SerializePath(*this);
 		}
 
 		return *this;
@@ -82,7 +251,8 @@ struct TSaveGameProxyArchive : public FNameAsStringProxyArchive
 	}
 
 private:
-	TMap<FSoftObjectPath, FSoftObjectPath>& Redirects;
+	FSaveGameRedirects& Redirects;
+	FSaveGameNameTable* NameTable;
 
 	template <typename ObjectType>
 	static FSoftObjectPath ToSoftObjectPath(const ObjectType& Value)
@@ -95,29 +265,80 @@ private:
 		return FSoftObjectPath(Value.Get());
 	}
 
+	static const UObject* GetObject(const UObject* Value) { return Value; }
+	static const UObject* GetObject(const FWeakObjectPtr& Value) { return Value.Get(); }
+	static const UObject* GetObject(const FObjectPtr& Value) { return Value.Get(); }
+
 	template <typename ObjectType>
 	FArchive& SerializeObject(ObjectType& Value)
 	{
+		if (!bIsLoading && NameTable)
+		{
+			// The table caches each object's path, so it only has to be built the first time it's referenced
+			uint32 Index = NameTable->AddObject(GetObject(Value));
+			SerializeIntPacked(Index);
+			return *this;
+		}
+
 		FSoftObjectPath Path;
 
 		if (!bIsLoading)
 		{
 			Path = ToSoftObjectPath(Value);
+			*this << Path;
+			return *this;
 		}
 
-		*this << Path;
+		// The cached object is what the path resolved to the first time, which is used if it's still around
+		UObject* Object = nullptr;
+		LoadPath(Path, Object);
 
-		if (bIsLoading)
+		if (!IsValid(Object))
 		{
-			UObject* Object = Path.ResolveObject();
-			Value = Object;
+			Object = Path.ResolveObject();
+		}
 
-			if (!IsValid(Object) && !Path.IsNull())
-			{
-				Value = Path.TryLoad();
-			}
+		if (!IsValid(Object) && !Path.IsNull())
+		{
+			Object = Path.TryLoad();
 		}
 
+		Value = Object;
 		return *this;
 	}
+
+	/**
+	 * Reads a path and resolves its redirects. With a name table, what each of its paths resolves to is cached by our
+	 * redirects, in which case OutObject is the object that the path was first resolved to (if it was found).
+	 */
+	void LoadPath(FSoftObjectPath& OutPath, UObject*& OutObject)
+	{
+		if (!NameTable)
+		{
+			OutPath.SerializePath(*this);
+			Redirects.Resolve(OutPath);
+			return;
+		}
+
+		uint32 Index = 0;
+		SerializeIntPacked(Index);
+
+		bool bShouldCache = false;
+		if (const FSaveGameRedirects::FReference* Reference = Redirects.FindReference(Index, bShouldCache))
+		{
+			OutPath = Reference->Path;
+			OutObject = Reference->Object.Get();
+			return;
+		}
+
+		OutPath = NameTable->GetPath(Index);
+		Redirects.Resolve(OutPath);
+
+		if (bShouldCache)
+		{
+			// Paths that were only saved by soft references don't need their object
+			OutObject = NameTable->IsObjectPath(Index) && !OutPath.IsNull() ? OutPath.ResolveObject() : nullptr;
+			Redirects.CacheReference(Index, OutPath, OutObject);
+		}
+	}
 };
@@ -2,10 +2,36 @@
 
 #pragma once
 
+#include "SaveGameContainer.h"
+#include "SaveGameFileWriter.h"
+#include "SaveGameProxyArchive.h"
+#include "Experimental/ConcurrentLinearAllocator.h"
+#include "Serialization/StructuredArchive.h"
 #include "Templates/ChooseClass.h"
 #include "Tasks/Task.h"
 
+class ULevel;
 class USaveGameSubsystem;
+class FSaveGamePropertySnapshotLayout;
+struct FSaveGameActorCache;
+struct FSaveGameLoadContext;
+struct FSaveGamePendingLevel;
+
+/** Blocks for the per-operation scratch memory of the serializer, kept apart from other linear allocations */
+struct FSaveGameArenaBlockTag : FDefaultBlockAllocationTag
+{
+	static constexpr const char* TagName = "SaveGameArena";
+};
+
+/**
+ * Holds the scratch memory of a single save or load (each actor's archives, data and snapshot), which is bump
+ * allocated from blocks cached per thread, so that actors serialized in parallel don't contend on the allocator.
+ * Objects created in it are destructed, and its memory released, in one go.
+ */
+using FSaveGameArena = TConcurrentLinearBulkObjectAllocator<FSaveGameArenaBlockTag>;
+
+/** A byte array that grows within the arena's blocks */
+using FSaveGameArenaArray = TArray<uint8, TConcurrentLinearArrayAllocator<FSaveGameArenaBlockTag>>;
 
 template <bool bIsLoading>
 class TSaveGameArchive;
@@ -22,37 +48,46 @@ public:
 /**
  * WorldSerializationManager
  *
- * Manages serialization of the world data. The archive includes:
+ * Manages serialization of the world data. The archive is stored in a FSaveGameContainer, whose table of contents
+ * records where each of these sections (and each level's actors) are, and includes:
  * 
+ *  ─ Summary (uncompressed, read without the rest of the container, see FSaveGameSummary)
+ *     • Timestamp
+ *     • LastVisitedMapName
+ *     • PlayTime
+ *
  *  ─ Header
- *     • VERSION_OFFSET
  *     • ENGINE_VERSION
  *     • PACKAGE_VERSION
+ *     • Timestamp
+ *     • LastVisitedMapName
  * 
  *  ─ Data
- *     • LastVisitedMapName
- *     • Timestamp
- *     • WorldData
+ *     • Levels (one independently addressable chunk per ULevel)
  *       ◦ Level1
+ *         ▪ Name
  *         ▪ DestroyedActors
+ *         ▪ ColumnGroups (see USaveGameSettings::ColumnGroupThreshold)
+ *           › Class
+ *           › Rows (the actors in this group)
+ *           › Columns (the values of each SaveGame property)
  *         ▪ Actors
  *           › ActorName
  *           › Class (if spawned)
  *           › SpawnID (if implements ISaveGameSpawnActor)
- *           › SaveGameProperties
- *         ▪ SubLevel1
- *         ▪ SubLevel2
- *         ...
+ *           › SaveGameProperties (if not in a column group)
  *       ◦ Level2
  *       ...
  * 
  *  ─ Versions
  *     • VersionID
  *     • VersionNumber
+ *
+ *  ─ Names
+ *     • Names and object paths, which the data above references by index (see FSaveGameNameTable)
  */
-inline constexpr int VERSION_OFFSET_INDEX = 0;
-inline constexpr int ENGINE_VERSION_INDEX = 1;
-inline constexpr int PACKAGE_VERSION_INDEX = 2;
+inline constexpr int ENGINE_VERSION_INDEX = 0;
+inline constexpr int PACKAGE_VERSION_INDEX = 1;
 
 template <bool bIsLoading>
 class TSaveGameSerializer final : public FSaveGameSerializer
@@ -60,7 +95,8 @@ class TSaveGameSerializer final : public FSaveGameSerializer
 	using TSaveGameMemoryArchive = typename TChooseClass<bIsLoading, FMemoryReader, FMemoryWriter>::Result;
 
 public:
-	TSaveGameSerializer(USaveGameSubsystem* InSaveGameSubsystem, FString InSaveName);
+	/** @param InLevelToSnapshot - when saving, the level to serialize on its own rather than the world (see SnapshotLevel) */
+	TSaveGameSerializer(USaveGameSubsystem* InSaveGameSubsystem, FString InSaveName, ULevel* InLevelToSnapshot = nullptr);
 	virtual ~TSaveGameSerializer() override;
 
 	virtual bool IsLoading() const override { return bIsLoading; }
@@ -72,30 +108,140 @@ public:
 	/** Get the archive save name */
 	FString GetSaveName() const { return SaveName; }
 
+	/**
+	 * When loading, only loads a level that the last load left pending, as it has now been streamed in. The rest of
+	 * the save has already been applied, so the container isn't read and the map isn't travelled to.
+	 */
+	void SetPendingLevel(FSaveGamePendingLevel&& PendingLevel);
+
+	/**
+	 * When saving, serializes the level that we were made with into a pending level, as its actors are about to be
+	 * removed with it. Instead of DoOperation, and in full before returning, as the level is about to be streamed out.
+	 * Only the snapshots of its actors are taken on the game thread, which waits while they're serialized.
+	 */
+	FSaveGamePendingLevel SnapshotLevel();
+
+	/**
+	 * When saving, completes once the save has been written, with whether it was. With write-behind saves, this is
+	 * after DoOperation's task has completed (see USaveGameSettings::bWriteBehindSaves). Only valid once it has.
+	 */
+	UE::Tasks::TTask<bool> GetWriteTask() const { return WriteTask; }
+
+	/** Get the time spent on the game thread so far, which is spread over several frames when time sliced */
+	double GetGameThreadSeconds() const { return GameThreadSeconds; }
+
+	/** Get the most time spent on the game thread within a single frame, which is the hitch that we caused */
+	double GetMaxGameThreadFrameSeconds() const { return MaxGameThreadFrameSeconds; }
+
+	/** When loading, whether the save couldn't be read. Only valid once DoOperation's task has completed */
+	bool HasLoadFailed() const { return bLoadFailed; }
+
 private:
 	struct FActorInfo;
 	struct FLevelInfo;
+	struct FColumnGroup;
 	struct FWorldInfo;
+	class FSnapshotReferencer;
+	class FPackageReferencer;
+	struct FMergeState;
 
-	void SerializeVersionOffset();
-
-	/** Serializes information about the archive, like Map Name, and position of versioning information */
+	/** Serializes information about the archive, like Map Name and Timestamp */
 	void SerializeHeader();
 
 	/**
-	 * Serializes all the actors that the SaveGameSubsystem is keeping track of.
-	 * On load, it will also pre-spawn any actors and map any actors with Spawn IDs
+	 * Gathers the levels that will be serialized. On save, groups the tracked actors and destroyed actors by the
+	 * level they belong to. On load, reads each level chunk's header and matches it to a resident level.
+	 */
+	void SerializeLevels();
+
+	/** Serializes the header of a level chunk (name, destroyed actors and column groups) */
+	void SerializeLevelHeader(FStructuredArchive::FRecord& Record, FLevelInfo& LevelInfo);
+
+	/**
+	 * Serializes the SaveGame properties of a column group's actors, one property at a time. On save, this writes the
+	 * group's columns from the actors' snapshots. On load, this applies the group's columns to its actors.
+	 */
+	void SerializeColumnGroup(FColumnGroup& Group);
+
+	/**
+	 * Serializes a range of the actors that the SaveGameSubsystem is keeping track of (in resident levels).
+	 * On load, the range must be every actor, as it will also pre-spawn any actors and map any actors with Spawn IDs
 	 * before running the actual serialization step.
+	 * On save, only a snapshot of each actor is taken on the game thread. The returned task completes once the
+	 * snapshots have been serialized on the task workers.
+	 */
+	UE::Tasks::FTask SerializeActors(int32 FirstActorIdx, int32 NumActors);
+
+	/**
+	 * When saving, serializes the actors over as many frames as needed to spend at most BudgetSeconds of each frame,
+	 * triggering CompletedEvent once they've all been serialized.
 	 */
-	void SerializeActors();
+	void SerializeActorsTimeSliced(double BudgetSeconds, UE::Tasks::FTaskEvent CompletedEvent);
+
+	/**
+	 * When loading, starts loading the packages of the objects that the save needs (see FSaveGameNameTable::IsObjectPath)
+	 * that aren't loaded, so that they're loaded alongside the map rather than one at a time as actors are spawned and
+	 * references are read. They're kept loaded until our actors have been applied.
+	 */
+	void LoadReferencedPackages();
 
 	void InitializeActor(int32 ActorIdx);
 	void SerializeActor(int32 ActorIdx);
 
+	/** When saving, the layout of the snapshots of a class's actors, which is built the first time it's needed */
+	const FSaveGamePropertySnapshotLayout& GetSnapshotLayout(const UClass* Class);
+
+	/** Serializes an actor's name, and its class and SpawnID (if it has them) */
+	void SerializeActorIdentity(FActorInfo& ActorInfo);
+
+	/** When saving, captures the data that an actor writes in OnSerialize, as it has to be read from the live actor */
+	void CaptureCustomData(int32 ActorIdx);
+
+	/**
+	 * Merges each actor's data (in order) as soon as it has been serialized, streaming it into the container.
+	 * Runs alongside SerializeActors. Each level is merged by a task nested in the calling one (see MergeLevel).
+	 */
 	void MergeSaveData();
 
-	/** Serializes any destroyed level actors. On load, level actors will exist again, so this will re-destroy them */
-	void SerializeDestroyedActors();
+	/**
+	 * Gathers a level's column groups once its actors have been serialized, and merges the rest of the level (see
+	 * WriteMergedLevel) in a task that waits on them, rather than blocking a worker. That task then merges the next.
+	 */
+	void MergeLevel(int32 LevelIdx);
+
+	/** Streams a level's header, column groups and actors, once its column groups have been serialized */
+	void WriteMergedLevel(int32 LevelIdx);
+
+	/** Streams a pending level's chunk as it is, as its level isn't resident (see FSaveGamePendingLevel) */
+	void WriteCarriedLevel(FLevelInfo& LevelInfo);
+
+	/** Adds a level that has been streamed to the table of contents */
+	void AddLevelSection(FLevelInfo& LevelInfo);
+
+	/** Opens the container that the save data is streamed into, writing straight to the save game file if we can */
+	void OpenContainerWriter();
+
+	/** Moves the data written so far into the container, optionally ending the container's current block */
+	void StreamSaveData(bool bEndBlock);
+
+	/** Hands a buffer to the container without copying it, as if it had been written to our data */
+	void StreamBuffer(const FSharedBuffer& Buffer);
+
+	/** Whether the container compresses with a dictionary, never when snapshotting a level (which has no container) */
+	bool UsesDictionary() const { return ContainerWriter.IsValid() && ContainerWriter->UsesDictionary(); }
+
+	/** Get the offset in the whole archive, including the data that has already been streamed into the container */
+	uint64 GetArchiveOffset() const { return StreamedSize + Archive.Tell(); }
+
+	/** Adds the time of one of our game thread tasks (or time slices), each of which runs within its own frame */
+	void AddGameThreadTime(double Seconds)
+	{
+		GameThreadSeconds += Seconds;
+		MaxGameThreadFrameSeconds = FMath::Max(MaxGameThreadFrameSeconds, Seconds);
+	}
+
+	/** Applies a level chunk's destroyed actors. On load, level actors will exist again, so this will re-destroy them */
+	void ApplyDestroyedActors(const FLevelInfo& LevelInfo);
 
 	/**
 	 * Serialized at the end of the archive, the versions are useful for marshaling old data.
@@ -103,22 +249,103 @@ private:
 	 */
 	void SerializeVersions();
 
+	/** When saving, replaces the subsystem's actor cache with the one that we built, if it's still the same world */
+	void HandOffActorCache(TMap<TWeakObjectPtr<AActor>, FSaveGameActorCache>&& ActorCache);
+
+	/** When loading, logs why the save can't be read. Anything that's left of the load is skipped */
+	void FailLoad(const FString& Reason);
+
+	/** When saving, writes the name table. It's written last, as names are added to it until then */
+	void SerializeNameTable();
+
+	/** The name table that our archives use, null when loading a save that predates it */
+	FSaveGameNameTable* GetNameTable();
+
+	/** When loading, what the levels that we leave pending need to be read later on */
+	TSharedPtr<FSaveGameLoadContext> GetLoadContext();
+
 	USaveGameSubsystem* Subsystem;
+
+	/** When saving, whether a JSON copy of the save is also written (see SaveGame.JsonOutputInterval) */
+	bool bJsonOutput;
+
 	TArray<uint8> Data;
 	TSaveGameMemoryArchive Archive;
-	TMap<FSoftObjectPath, FSoftObjectPath> Redirects;
+	FSaveGameRedirects Redirects;
+
+	/** When loading, the save's name table, shared with pending levels */
+	TSharedPtr<FSaveGameNameTable> LoadNameTable;
+
+	/**
+	 * When saving, USaveGameSubsystem::SaveNameTable as of when we were created. The subsystem can replace it while
+	 * we're saving (as its world is cleaned up), which mustn't change the table that we've been adding to.
+	 */
+	TSharedPtr<FSaveGameNameTable> SaveNameTable;
+
+	/** When loading, what's needed to read the levels that we leave pending (or the pending level we're loading) */
+	TSharedPtr<FSaveGameLoadContext> LoadContext;
+	bool bLoadingPendingLevel = false;
+
 	TSaveGameArchive<bIsLoading>* SaveArchive;
 
-	FTopLevelAssetPath LevelAssetPath;
-	TArray<uint64> ActorOffsets;
-	TArray<TWeakObjectPtr<AActor>> SaveGameActors;
+	/** Where each section of the archive is, written to (or read from) the container */
+	FSaveGameTableOfContents Toc;
+	FSaveGameContainerReader ContainerReader;
+
+	/** When saving, the container that our data is streamed into, and where it's being written */
+	TUniquePtr<FSaveGameContainerWriter> ContainerWriter;
+	TUniquePtr<FSaveGameFileWriter> FileWriter;
+	TUniquePtr<FArchive> ContainerArchive;
+	TArray<uint8> ContainerData;
+	uint64 StreamedSize = 0;
+	UE::Tasks::TTask<bool> WriteTask;
+
+	/**
+	 * When snapshotting a level, the level, which is alive until we return as the game thread waits on us. Our data
+	 * is streamed into SnapshotData instead of a container
+	 */
+	ULevel* LevelToSnapshot = nullptr;
+	TArray<uint8> SnapshotData;
+
+	TArray<FLevelInfo> Levels;
+
+	/** Declared before ActorData, as it owns what the actors' archives are made of */
+	FSaveGameArena Arena;
+
+	/** Declared before ActorData, as the actors' snapshots reference them */
+	FRWLock SnapshotLayoutsLock;
+	TMap<FObjectKey, TUniquePtr<FSaveGamePropertySnapshotLayout>> SnapshotLayouts;
+
 	TArray<FActorInfo> ActorData;
 	TMap<FGuid, TWeakObjectPtr<AActor>> SpawnIDs;
 
+	/** When saving, keeps the objects referenced by the actors' snapshots alive until they've been serialized */
+	TUniquePtr<FSnapshotReferencer> SnapshotReferencer;
+
+	/** When loading, keeps the packages that the save needs (and their load requests) until our actors are applied */
+	TUniquePtr<FPackageReferencer> PackageReferencer;
+
+	/** When saving incrementally, the actors that were marked dirty since the last save */
+	TSet<TWeakObjectPtr<AActor>> DirtyActors;
+	bool bIncrementalSave = false;
+
+	/** When saving, what's carried between the levels being merged */
+	TUniquePtr<FMergeState> MergeState;
+
+	/** When saving, the world that we're saving, which our actor cache belongs to (see HandOffActorCache) */
+	TWeakObjectPtr<UWorld> SavedWorld;
+
 	FString LastVisitedMap;
-	uint64 ActorOffsetsOffset;
-	uint64 VersionOffset;
-	uint64 ActorsOffset;
+
+	/** Set by whichever step of the load failed, which can be a worker reading the levels while we're travelling */
+	std::atomic<bool> bLoadFailed = false;
+
+	double GameThreadSeconds = 0.0;
+	double MaxGameThreadFrameSeconds = 0.0;
+
+	/** The container's summary. When saving, it's filled out as the container is opened (other than the play time,
+	 * which is taken when the save starts). When loading, it's only set if the container has one */
+	TOptional<FSaveGameSummary> Summary;
 
 	FString SaveName;
 };
@@ -27,6 +27,15 @@ public:
 	TObjectPtr<UEnum> Enum;
 };
 
+/** How much effort is spent on compressing save games, trading save time for size */
+UENUM()
+enum class ESaveGameCompressionLevel : uint8
+{
+	Fastest,
+	Normal,
+	Smallest,
+};
+
 /**
  * Manages save game-specific settings including versioning and debug options.
  * Derived from UDeveloperSettings to allow configuration through project settings.
@@ -39,21 +48,134 @@ class SAVEGAMEPLUGIN_API USaveGameSettings : public UDeveloperSettings
 	/**
 	 * Retrieves the unique identifier (GUID) associated with a specific versioning enum.
 	 *
-	 * This function ensures synchronization when accessing the cached version mapping
-	 * and computes the mapping of enums to their respective GUIDs if not already cached.
+	 * This function reads the published mapping of enums to their respective GUIDs without locking,
+	 * and only publishes the mapping itself if it hasn't been published yet.
 	 *
 	 * @param VersionEnum The enum used for versioning. It should represent valid versioning data.
 	 * @return The GUID associated with the specified version enum. Returns an invalid GUID if
 	 *         the enum is not found or mapping is not possible.
 	 */
 public:
-	/** Get the current project version ID */
+	/** Get the current project version ID, from any thread without locking (see PublishVersions) */
 	FGuid GetVersionId(const UEnum* VersionEnum) const;
 
+	/**
+	 * Publishes the version IDs that GetVersionId reads, if they've changed since they were last published. Called
+	 * (on the game thread) as each save or load starts, so that their parallel OnSerialize handlers only read them.
+	 */
+	void PublishVersions() const;
+
+	/** Get the latest version of one of our project versions by its ID (INDEX_NONE if it isn't one), on the game thread */
+	int32 GetLatestVersion(const FGuid& VersionId) const;
+
+	/** Returns true if the slot name is one of the autosave slots, as named by GetAutosaveSlotName */
+	bool IsAutosaveSlot(const FString& SlotName) const;
+
+	/** Get the name of an autosave slot, AutoSaveSlotName with "_#" appended */
+	FString GetAutosaveSlotName(int32 SlotIdx) const;
+
+	/** Get the compression level to use when saving to the specified slot */
+	ESaveGameCompressionLevel GetCompressionLevel(const FString& SlotName) const;
+
+	/** Get the number of task workers that actors are serialized on, see MaxWorkers */
+	int32 GetNumWorkers() const;
+
+	/** Get the game thread budget per frame (in seconds) when saving to the specified slot, 0 if it isn't time sliced */
+	double GetTimeSliceBudget(const FString& SlotName) const;
+
 	/** Determines whether debug information will be printed. Can be configured to enable or disable debug logs for diagnostics and development purposes. */
 	UPROPERTY(EditAnywhere, Config, Category = "Debug")
 	bool bPrintDebug = true;
 
+	/**
+	 * Reuses the serialized data of actors that haven't changed since the last save, instead of serializing them again.
+	 * Only actors that opt in with ISaveGameObject::CanReuseSaveData are reused. An actor is unchanged if the hash of
+	 * its SaveGame properties (and transform) still matches, and it hasn't been marked with
+	 * USaveGameSubsystem::MarkActorDirty.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Performance")
+	bool bIncrementalSaves = false;
+
+	/**
+	 * The maximum number of task workers that actors are serialized on, so that saving and loading doesn't starve
+	 * other systems (like streaming and audio) of workers. 0 uses all but one of the workers.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Performance", meta = (ClampMin = 0, UIMin = 0))
+	int32 MaxWorkers = 0;
+
+	/**
+	 * When a level has at least this many saved actors of the same class, their SaveGame properties are stored
+	 * together in a column group rather than in each actor's record (0 stores every actor on its own). A column group
+	 * lists the class's properties once, followed by one column of values per property, which compresses far better
+	 * than thousands of records that each repeat their property tags. Actors in a column group aren't reused by
+	 * incremental saves, as their properties are serialized along with the rest of their group.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Performance", meta = (ClampMin = 0, UIMin = 0))
+	int32 ColumnGroupThreshold = 0;
+
+	/**
+	 * The grid that actor locations are snapped to when saved by USaveGameFunctionLibrary::SerializeActorTransform.
+	 * Locations too far from the origin to fit on the grid (about 214km at 0.01cm) are saved as they are, as are all
+	 * locations when this is 0.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Performance", meta = (ClampMin = 0, UIMin = 0, Units = "cm"))
+	float TransformPositionPrecision = 0.01f;
+
+	/**
+	 * Quantizes the transforms saved by USaveGameFunctionLibrary::SerializeActorTransform, see FSaveGameTransform.
+	 * Rotations are always slightly lossy when quantized, so turn this off to save transforms at full precision.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Performance")
+	bool bQuantizeTransforms = true;
+
+	/**
+	 * Spreads the snapshots of actors taken during an autosave over several frames, spending at most this many
+	 * milliseconds of the game thread per frame (0 takes every actor's snapshot within a single frame).
+	 * The levels and actors that are saved are gathered when the save starts. Each actor is saved as it was when its
+	 * snapshot was taken, so actors whose snapshots were taken in different frames may be slightly out of sync.
+	 * Actors spawned during the save are left for the next one, level actors destroyed during it are saved as destroyed.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Performance", meta = (ClampMin = 0, UIMin = 0, Units = "ms"))
+	float AutosaveTimeSliceMs = 2.0f;
+
+	/** Same as AutosaveTimeSliceMs, but for manual saves, which are usually made while the game is paused */
+	UPROPERTY(EditAnywhere, Config, Category = "Performance", meta = (ClampMin = 0, UIMin = 0, Units = "ms"))
+	float ManualSaveTimeSliceMs = 0.0f;
+
+	/**
+	 * With the generic save game system (which desktop platforms use), writes save files behind the save. The file is
+	 * written in large chunks on an I/O pipe of its own, so the save is done (see USaveGameSubsystem::OnSaveDone) as
+	 * soon as the last of it is handed over, and USaveGameSubsystem::OnSaveWritten is called once it's on disk. Saves
+	 * and loads that follow still wait for it. Otherwise, the save game system is handed the save once it's done.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Performance")
+	bool bWriteBehindSaves = true;
+
+	/** The compression format for save games (i.e. Zlib, Oodle, LZ4, Gzip), must be supported by FCompression */
+	UPROPERTY(EditAnywhere, Config, Category = "Compression")
+	FName CompressionFormat = NAME_Zlib;
+
+	/** Compression level used for saves made by the player (or gameplay code) */
+	UPROPERTY(EditAnywhere, Config, Category = "Compression")
+	ESaveGameCompressionLevel ManualSaveCompressionLevel = ESaveGameCompressionLevel::Normal;
+
+	/** Compression level used for autosaves, which should favour speed */
+	UPROPERTY(EditAnywhere, Config, Category = "Compression")
+	ESaveGameCompressionLevel AutosaveCompressionLevel = ESaveGameCompressionLevel::Fastest;
+
+	/** Save games are split into blocks of this size (in KB) that are compressed and decompressed in parallel */
+	UPROPERTY(EditAnywhere, Config, Category = "Compression", meta = (ClampMin = 16, UIMin = 16))
+	int32 CompressionBlockSizeKB = 256;
+
+	/**
+	 * A dictionary trained on representative saves by the SaveGameTrainDictionary commandlet, relative to the
+	 * project's content directory. When using Zlib, every actor is then compressed in its own block, so that it can be
+	 * decompressed on its own. Be sure to stage this file (i.e. "Additional Non-Asset Directories to Package").
+	 * Saves compressed with a dictionary can only be loaded with that same dictionary.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Compression")
+	FString CompressionDictionary;
+
 	/** Enables or disables the auto-save timer functionality */
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "AutoSave", meta = (InlineEditConditionToggle))
 	bool bEnableAutoSaveTimer = false;
@@ -72,12 +194,23 @@ public:
 	UPROPERTY(Config, EditDefaultsOnly, BlueprintReadOnly, Category = "AutoSave", meta = (EditCondition = "bEnableAutoSaveTimer"))
 	FString AutoSaveSlotName = TEXT("Autosave");
 
+	/**
+	 * An autosave that's due waits for a frame that took at most this long, so that it isn't added to a frame that's
+	 * already slow (0 doesn't wait for one). Autosaves also wait for level streaming and other saves or loads.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "AutoSave", meta = (EditCondition = "bEnableAutoSaveTimer", ClampMin = 0, UIMin = 0, Units = "ms"))
+	float AutoSaveQuietFrameTimeMs = 20.0f;
+
+	/** The longest that a due autosave waits for a quiet frame (or for streaming to finish), before it's made anyway */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "AutoSave", meta = (EditCondition = "bEnableAutoSaveTimer", ClampMin = 0, UIMin = 0, Units = "s"))
+	float AutoSaveMaxDelay = 30.0f;
+
 #if WITH_EDITOR
 	/**
 	 * Handles changes made to properties in the editor.
 	 * Overrides the base class implementation to provide custom behavior when
-	 * specific properties are modified, ensuring thread safety and resetting
-	 * cached version data when necessary.
+	 * specific properties are modified, marking the published version data
+	 * to be published again when necessary.
 	 *
 	 * @param PropertyChangedEvent Information about the property that was changed,
 	 *                             including which property was modified.
@@ -95,12 +228,16 @@ protected:
 	TArray<FSaveGameVersionInfo> Versions;
 
 private:
+	/** The version ID of each version enum, which is never changed once published */
+	using FVersionIds = TMap<const UEnum*, FGuid>;
+
+	/** The latest published version IDs */
+	mutable std::atomic<const FVersionIds*> PublishedVersions = nullptr;
+
+	/** Every version IDs published, as they may still be read after they've been replaced (only in the editor) */
+	mutable TArray<TUniquePtr<const FVersionIds>> VersionIdsHistory;
+
+	/** Guards publishing, and whether the version IDs need to be published again as Versions has changed */
 	mutable FCriticalSection VersionsSection;
-	/**
-	 * A mutable map that caches associations between versioning enums and their unique IDs.
-	 * This is used internally to improve performance by avoiding redundant lookups or recalculations
-	 * of versioning relationships during runtime.
-	 * Thread safety is ensured using the VersionsSection critical section.
-	 */
-	mutable TMap<TObjectPtr<UEnum>, FGuid> CachedVersions;
+	mutable bool bVersionsChanged = true;
 };
@@ -0,0 +1,59 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SaveGameContainer.h"
+#include "HAL/CriticalSection.h"
+
+class ISaveGameSystem;
+struct FSaveGameSlotInfo;
+
+/**
+ * The summaries of the save slots, cached in a file next to them so that listing the slots only has to check that
+ * each slot's file hasn't changed since it was indexed. Slots that have changed only have their summary read, rather
+ * than their whole container. Slots that aren't files (on platforms with their own save game system) are loaded to
+ * read their summary, which is kept in memory (rather than indexed) until the slot is written again.
+ */
+class SAVEGAMEPLUGIN_API FSaveGameSlotIndex
+{
+public:
+	/**
+	 * Get the summary of each of the user's save slots, writing the index out again if any slot had changed. Can be
+	 * called from any thread, though slots are only listed by one at a time.
+	 */
+	void GetSlots(ISaveGameSystem* SaveSystem, int32 UserIndex, TArray<FSaveGameSlotInfo>& OutSlots);
+
+	/** Forgets the summary of a slot that isn't a file, as it has been written again */
+	void InvalidateSlot(const FString& SaveName);
+
+private:
+	struct FEntry
+	{
+		/** The size and modification time of the slot's file when it was indexed */
+		int64 FileSize = 0;
+		FDateTime FileTimestamp;
+
+		/** Unset if the slot's container predates summaries */
+		TOptional<FSaveGameSummary> Summary;
+
+		friend FArchive& operator<<(FArchive& Ar, FEntry& Entry)
+		{
+			return Ar << Entry.FileSize << Entry.FileTimestamp << Entry.Summary;
+		}
+	};
+
+	static FString GetIndexFilePath();
+
+	/** Reads the index file, if it hasn't been read yet. An index written by another container version is ignored */
+	void LoadIndex();
+	void SaveIndex();
+
+	FCriticalSection Lock;
+	TMap<FString, FEntry> Entries;
+
+	/** The summaries of slots that aren't files, which can't tell whether they've changed (see InvalidateSlot) */
+	TMap<FString, FEntry> UnindexedEntries;
+
+	bool bLoaded = false;
+};
@@ -5,15 +5,88 @@
 #include "Tasks/Pipe.h"
 
 #include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Memory/SharedBuffer.h"
+#include "Misc/EngineVersionBase.h"
+#include "SaveGameNameTable.h"
+#include "SaveGameSlotIndex.h"
+#include "Serialization/CustomVersion.h"
+#include "UObject/ObjectVersion.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "SaveGameTypes.h"
 #include "SaveGameSubsystem.generated.h"
 
+class FSaveGameRedirects;
 class USaveGameSettings;
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FSaveLoadStart);
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FSaveLoadDone);
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSaveWritten, bool, bSucceeded);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FLoadDone, bool, bSucceeded);
+
+DECLARE_DYNAMIC_DELEGATE_OneParam(FSaveSlotsListed, const TArray<FSaveGameSlotInfo>&, Slots);
+
+/** An actor's serialized data from the last save, reused by incremental saves if the actor hasn't changed */
+struct FSaveGameActorCache
+{
+	/** Hash of the actor's SaveGame state when this data was serialized */
+	uint32 PropertyHash = 0;
+
+	/** Shared with the container writer, so that it isn't copied when it's reused. Its names and paths are indices
+	 * into USaveGameSubsystem::SaveNameTable, which is kept for as long as the cache is */
+	FSharedBuffer Data;
+	FCustomVersionContainer Versions;
+
+#if WITH_TEXT_ARCHIVE_SUPPORT
+	/** The actor's JSON, empty if it was cached by a save without JSON output */
+	TArray<uint8> Json;
+#endif
+};
+
+/** What's needed to read the level chunks of a loaded save, shared by the levels that it left pending */
+struct FSaveGameLoadContext
+{
+	FString SaveName;
+	FPackageFileVersion PackageVersion;
+	FEngineVersionBase EngineVersion;
+	FCustomVersionContainer Versions;
+
+	/** Null if the save predates the name table */
+	TSharedPtr<FSaveGameNameTable> NameTable;
+
+	/**
+	 * The redirects of the spawned actors that were renamed by the load (and the pending levels loaded since), as the
+	 * actors of pending levels can reference them. Null for levels that were streamed out, whose paths are current.
+	 */
+	TSharedPtr<FSaveGameRedirects> Redirects;
+
+	/**
+	 * Whether the chunks were written with the versions that this build writes, so that they can be carried into a
+	 * save as they are (see FSaveGamePendingLevel)
+	 */
+	bool bLatestVersions = false;
+};
+
+/**
+ * A level chunk of the last loaded save, whose level wasn't resident when it was loaded, or of a level that has since
+ * been streamed out (see USaveGameSubsystem::OnPreLevelRemovedFromWorld). It's kept in its serialized form until the
+ * level is streamed in, and only then are its actors deserialized and applied. Saves made meanwhile carry it over as
+ * it is, if its names are in USaveGameSubsystem::SaveNameTable and it has the latest versions.
+ */
+struct FSaveGamePendingLevel
+{
+	/** Shared with the saves that carry it over */
+	FSharedBuffer Data;
+
+	/** Offsets of each actor's data in Data */
+	TArray<uint32> ActorOffsets;
+
+	TSharedPtr<FSaveGameLoadContext> Context;
+};
+
 /**
  * Subsystem responsible for managing game save operations.
  * Provides functionality for saving and loading game data across levels and sessions.
@@ -33,13 +106,17 @@ public:
 	UPROPERTY(BlueprintAssignable)
 	FSaveLoadStart OnLoadStart;
 
-	/** Called when the system finished saving a level */
+	/** Called when the system finished saving a level, which may still be being written (see OnSaveWritten) */
 	UPROPERTY(BlueprintAssignable)
 	FSaveLoadDone OnSaveDone;
 
-	/** Called when the system finished loading a level */
+	/** Called once a save has been written to its slot, after OnSaveDone */
+	UPROPERTY(BlueprintAssignable)
+	FSaveWritten OnSaveWritten;
+
+	/** Called when the system finished loading a level, or couldn't read the save (in which case nothing changed) */
 	UPROPERTY(BlueprintAssignable)
-	FSaveLoadDone OnLoadDone;
+	FLoadDone OnLoadDone;
 
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
@@ -56,9 +133,43 @@ public:
 	UFUNCTION(BlueprintCallable, Category="SaveGamePlugin|Load")
 	void Load(FString SaveName);
 
+	/**
+	 * Save to the next of the autosave slots, which are rotated through so that the oldest is overwritten. Autosaves
+	 * are also made every USaveGameSettings::AutoSaveInterval seconds, if the timer is enabled.
+	 */
+	UFUNCTION(BlueprintCallable, Category="SaveGamePlugin|Save")
+	void Autosave();
+
+	/** Get what autosaves have cost so far, to tune the autosave interval against */
+	UFUNCTION(BlueprintPure, Category="SaveGamePlugin|Save")
+	FSaveGameAutosaveStats GetAutosaveStats() const { return AutosaveStats; }
+
 	UFUNCTION(BlueprintCallable, Category="SaveGamePlugin|Load")
 	bool IsLoadingSaveGame() const;
 
+	/**
+	 * Get the save slots, most recent first, along with when they were saved, their map and play time. Only the
+	 * uncompressed summary of each slot is read, and only if it has changed since it was last listed. Slots that
+	 * have changed are read on the calling thread, so prefer ListSaveSlots on the game thread.
+	 */
+	UFUNCTION(BlueprintCallable, Category="SaveGamePlugin|Load")
+	TArray<FSaveGameSlotInfo> GetSaveSlots();
+
+	/** Like GetSaveSlots, but lists the slots on a task, calling back on the game thread once they're listed */
+	UFUNCTION(BlueprintCallable, Category="SaveGamePlugin|Load")
+	void ListSaveSlots(FSaveSlotsListed OnListed);
+
+	/** Like GetSaveSlots, but lists the slots on a task */
+	UE::Tasks::TTask<TArray<FSaveGameSlotInfo>> GetSaveSlotsAsync();
+
+	/**
+	 * Marks an actor as changed, so that an incremental save will serialize it again instead of reusing its data
+	 * from the last save. Only needed for state that isn't a SaveGame property or transform (i.e. OnSerialize data).
+	 * @param Actor - the actor that has changed
+	 */
+	UFUNCTION(BlueprintCallable, Category="SaveGamePlugin|Save", meta=(DefaultToSelf="Actor"))
+	void MarkActorDirty(AActor* Actor);
+
 	/** Get the last known Savetime of the save archive
 	 * Time is expressed in UTC time, convert to local time if needed
 	 */
@@ -67,14 +178,42 @@ public:
 
 	void SetLastSaveTimestamp(FDateTime Timestamp) { LastSaveTimestamp = Timestamp; }
 
+	/** Get the unpaused seconds played, carried over from the last loaded save and from world to world */
+	UFUNCTION(BlueprintPure, Category="SaveGamePlugin")
+	double GetPlayTime() const;
+
+	/** Sets the play time so far, from which it carries on counting */
+	void SetPlayTime(double PlayTime);
+
 protected:
 	void OnWorldInitialized(UWorld* World, const UWorld::InitializationValues);
 	void OnActorsInitialized(const FActorsInitializedParams& Params);
 	void OnLevelAddedToWorld(ULevel* Level, UWorld* World);
+
+	/** Keeps what a level's actors would save as a pending level, as they're about to be removed along with it */
 	void OnPreLevelRemovedFromWorld(ULevel* Level, UWorld* World);
+
 	void OnWorldCleanup(UWorld* World, bool, bool);
 	void OnPreWorldDestroyed(UWorld* World);
 
+	/**
+	 * Makes an autosave once the interval has passed since the last save, in a quiet frame. Waits while a save or load
+	 * is running, and (for at most USaveGameSettings::AutoSaveMaxDelay) while levels are streaming or frames are slow.
+	 */
+	bool TickAutosave(float DeltaTime);
+
+	/** Logs and records the cost of an autosave, from any thread */
+	void ReportAutosave(double DurationSeconds, double GameThreadSeconds, double HitchSeconds);
+
+	/**
+	 * The slot after the most recent autosave, so that rotation carries on from where the last session left off. The
+	 * slots are listed on a task, once, as the rotation is tracked from then on (see NextAutosaveSlot).
+	 */
+	UE::Tasks::TTask<int32> FindNextAutosaveSlot();
+
+	/** Applies a level of the last loaded save, now that the level has been streamed in */
+	void LoadPendingLevel(FSaveGamePendingLevel&& PendingLevel);
+
 	void OnActorPreSpawn(AActor* Actor);
 	void OnActorDestroyed(AActor* Actor);
 
@@ -83,9 +222,6 @@ protected:
 	UPROPERTY()
 	USaveGameSettings* SaveGameSettings;
 
-	UPROPERTY(VisibleAnywhere, Category="Save Game")
-	TMap<TSoftObjectPtr<UWorld>, FWorldSaveData> WorldData;
-
 	UPROPERTY(VisibleAnywhere, Category="Save Game")
 	TSet<FSoftObjectPath> DestroyedLevelActors;
 
@@ -97,6 +233,46 @@ private:
 	friend class TSaveGameSerializer;
 	UE::Tasks::FPipe SaveGamePipe = UE::Tasks::FPipe(TEXT("SaveGameSubsystem"));
 
+	/** Writes the JSON copies of saves, which saves don't wait on */
+	UE::Tasks::FPipe JsonOutputPipe = UE::Tasks::FPipe(TEXT("SaveGameJsonOutput"));
+
+	/** Actors that have been marked dirty since the last save */
+	TSet<TWeakObjectPtr<AActor>> DirtyActors;
+
+	/** Serialized data of each actor from the last save, see USaveGameSettings::bIncrementalSaves */
+	TMap<TWeakObjectPtr<AActor>, FSaveGameActorCache> ActorCache;
+
+	/**
+	 * The levels of the last loaded save that weren't resident, and the levels streamed out since, which are applied
+	 * as they're streamed in
+	 */
+	TMap<FTopLevelAssetPath, FSaveGamePendingLevel> PendingLevels;
+
+	/**
+	 * The name table of saves. It's carried over from one save to the next while there's cached actor data or pending
+	 * levels, as they reference it, and is emptied otherwise. It's replaced along with them when a save is loaded (by
+	 * the save's own if it leaves levels pending) or the world is cleaned up. Object paths are cached per save.
+	 */
+	TSharedRef<FSaveGameNameTable> SaveNameTable = MakeShared<FSaveGameNameTable>();
+
+	/** The summaries of the save slots, see GetSaveSlots. Shared with the tasks that list them */
+	TSharedRef<FSaveGameSlotIndex> SlotIndex = MakeShared<FSaveGameSlotIndex>();
+
+	FTSTicker::FDelegateHandle AutosaveTickerHandle;
+
+	/** Unpaused seconds since the last save (or load) */
+	float AutosaveElapsed = 0.0f;
+
+	/** The autosave slot that's next in the rotation, INDEX_NONE until FindNextAutosaveSlot has found it */
+	int32 NextAutosaveSlot = INDEX_NONE;
+	UE::Tasks::TTask<int32> NextAutosaveSlotTask;
+
+	UPROPERTY(VisibleAnywhere, Category="Save Game")
+	FSaveGameAutosaveStats AutosaveStats;
+
+	/** Play time before the current world began, as the world's time starts over with each world */
+	double PlayTimeOffset = 0.0;
+
 	/** Holds the last known timestamp for saving/loading */
 	UPROPERTY(VisibleAnywhere, Category="Save Game")
 	FDateTime LastSaveTimestamp;
@@ -2,8 +2,12 @@
 
 #pragma once
 
+#include "Math/MathFwd.h"
+#include "Tasks/Task.h"
 #include "Templates/FunctionFwd.h"
 
+class AActor;
+
 class ISaveGameThreadQueue
 {
 public:
@@ -13,6 +17,13 @@ public:
 
 	virtual ~ISaveGameThreadQueue() = default;
 	virtual void AddTask(FTaskFunction&& Task) = 0;
+
+	/**
+	 * Queues up setting an actor's transform. Transforms that are queued one after the other (with no task queued in
+	 * between) are set together, in one pass (see FSaveGameTransformBatch), rather than each being a task of its own.
+	 * They're still set in the order that they were queued in, relative to tasks.
+	 */
+	virtual void AddTransform(AActor* Actor, const FTransform& Transform) = 0;
 };
 
 class FSaveGameTheadScope
@@ -21,5 +32,9 @@ public:
 	FSaveGameTheadScope();
 	~FSaveGameTheadScope();
 
-	bool ProcessThread(int64 WaitCycles) const;
+	/**
+	 * Runs the work queued for this thread until the task has completed (and nothing is left in the queue).
+	 * Sleeps while there's nothing to do, rather than polling.
+	 */
+	void ProcessUntil(const UE::Tasks::FTask& Task) const;
 };
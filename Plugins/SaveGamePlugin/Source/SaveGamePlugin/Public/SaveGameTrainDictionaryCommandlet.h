@@ -0,0 +1,24 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SaveGameTrainDictionaryCommandlet.generated.h"
+
+/**
+ * Trains a compression dictionary on the actors of existing save game slots, and writes it to the project's
+ * USaveGameSettings::CompressionDictionary (or the path given by -Output=, relative to the content directory).
+ *
+ * Usage: -run=SaveGameTrainDictionary [-Output=SaveGame/SaveGame.dict] [-Size=32768] [-User=0]
+ */
+UCLASS()
+class SAVEGAMEPLUGIN_API USaveGameTrainDictionaryCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USaveGameTrainDictionaryCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
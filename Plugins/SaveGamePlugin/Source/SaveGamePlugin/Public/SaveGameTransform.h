@@ -0,0 +1,41 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/StructuredArchive.h"
+
+/**
+ * Transforms as they're stored in a save game, which are quantized rather than stored as ten doubles. Positions are
+ * snapped to a grid (see USaveGameSettings::TransformPositionPrecision), rotations keep the three smallest components
+ * of their quaternion, and scales only store as many components as they differ by. Transforms are stored at full
+ * precision instead if USaveGameSettings::bQuantizeTransforms is off.
+ */
+class SAVEGAMEPLUGIN_API FSaveGameTransform
+{
+public:
+	static void Serialize(FStructuredArchive::FSlot Slot, FTransform& Transform);
+};
+
+/**
+ * Actor transforms that were loaded on the task workers, which are applied on the game thread in one pass, rather than
+ * each being queued up on their own (see ISaveGameThreadQueue::AddTransform).
+ */
+class SAVEGAMEPLUGIN_API FSaveGameTransformBatch
+{
+public:
+	/** Adds an actor's transform to be applied, from any thread */
+	void Add(AActor* Actor, const FTransform& Transform);
+
+	/** Applies (and empties) the batch, on the game thread */
+	void Apply();
+
+private:
+	FCriticalSection Lock;
+
+	/** Kept apart, so that applying them walks through each in order */
+	TArray<TWeakObjectPtr<AActor>> Actors;
+	TArray<FVector> Locations;
+	TArray<FQuat> Rotations;
+	TArray<FVector> Scales;
+};
@@ -5,30 +5,58 @@
 #include "SaveGameTypes.generated.h"
 
 /**
-* The save data of an individual level within a world
-* We store all the actors that implemented the save game interface
-* We also keep track of the actors that get destroyed at runtime so we can destroy them again upon loading the save data.
+ * What a save slot is shown with in a load menu, read from its container's summary (see
+ * USaveGameSubsystem::GetSaveSlots)
  */
 USTRUCT(BlueprintType)
-struct FLevelSaveData
+struct FSaveGameSlotInfo
 {
 	GENERATED_BODY()
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SaveSystem")
-	TSet<TSoftObjectPtr<AActor>> SaveGameActors;
+	UPROPERTY(BlueprintReadOnly, Category = "SaveSystem")
+	FString SaveName;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SaveSystem")
-	TSet<FSoftObjectPath> DestroyedLevelActors;
+	/** When the save was made, in UTC */
+	UPROPERTY(BlueprintReadOnly, Category = "SaveSystem")
+	FDateTime Timestamp;
+
+	UPROPERTY(BlueprintReadOnly, Category = "SaveSystem")
+	FString LastVisitedMap;
+
+	UPROPERTY(BlueprintReadOnly, Category = "SaveSystem")
+	FTimespan PlayTime;
+
+	/** Size of the save on disk, in bytes */
+	UPROPERTY(BlueprintReadOnly, Category = "SaveSystem")
+	int64 Size = 0;
+
+	/** False for saves that predate summaries, which only have their name and size */
+	UPROPERTY(BlueprintReadOnly, Category = "SaveSystem")
+	bool bHasSummary = false;
 };
 
-/**
- * The save data of all levels within a world
- */
+/** What autosaves have cost, see USaveGameSubsystem::GetAutosaveStats */
 USTRUCT(BlueprintType)
-struct FWorldSaveData
+struct FSaveGameAutosaveStats
 {
 	GENERATED_BODY()
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SaveSystem")
-	TMap<FName, FLevelSaveData> SubLevels;
+	UPROPERTY(BlueprintReadOnly, Category = "SaveSystem")
+	int32 NumAutosaves = 0;
+
+	/** How long the last autosave took, from starting until it was done (not counting its write-behind) */
+	UPROPERTY(BlueprintReadOnly, Category = "SaveSystem")
+	float LastDurationMs = 0.0f;
+
+	/** The game thread time of the last autosave, over all of the frames that it was time sliced over */
+	UPROPERTY(BlueprintReadOnly, Category = "SaveSystem")
+	float LastGameThreadMs = 0.0f;
+
+	/** The most game thread time that the last autosave took in a single frame */
+	UPROPERTY(BlueprintReadOnly, Category = "SaveSystem")
+	float LastHitchMs = 0.0f;
+
+	/** The most game thread time that any autosave took in a single frame */
+	UPROPERTY(BlueprintReadOnly, Category = "SaveSystem")
+	float MaxHitchMs = 0.0f;
 };
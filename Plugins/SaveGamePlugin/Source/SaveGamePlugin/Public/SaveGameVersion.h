@@ -10,6 +10,27 @@ class SAVEGAMEPLUGIN_API FSaveGameVersion
 public:
 	enum Type
 	{
+		// Actors and destroyed actors are stored in one chunk per level
+		LevelChunks = 0,
+
+		// Section offsets are stored in the container's table of contents, rather than in the archive
+		TableOfContents,
+
+		// Names and object paths are stored as indices into the save's name table, rather than as strings
+		NameTable,
+
+		// Object fields are stored in a compact directory of name indices and packed offsets, rather than in a map
+		FieldDirectory,
+
+		// Level chunks have column groups, and actor records only have properties if they aren't in one
+		ColumnGroups,
+
+		// Transforms written by USaveGameFunctionLibrary::SerializeActorTransform are quantized (see FSaveGameTransform)
+		QuantizedTransforms,
+
+		// Columns are records of which rows have values and the values, rather than a bit array followed by values
+		StructuredColumns,
+
 		// -----<new versions can be added above this line>-------------------------------------------------
 		VersionPlusOne,
 		LatestVersion = VersionPlusOne - 1
@@ -22,6 +22,9 @@ public class SaveGamePlugin : ModuleRules
 			"Json",
 		});
 
+		// Used directly for preset dictionaries, which FCompression doesn't expose
+		AddEngineThirdPartyPrivateStaticDependencies(Target, "zlib");
+
 		if (Target.Type == TargetType.Editor)
 		{
 			PrivateDependencyModuleNames.AddRange(new string[]